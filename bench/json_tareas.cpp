@@ -0,0 +1,163 @@
+// Serialización de un listado de tareas: Tarea::appendJson sobre un buffer
+// reutilizado frente al camino anterior, un crow::json::wvalue por tarea y
+// dump(). Sin Crow instalado se usa una réplica de ese camino: un mapa por
+// tarea con una clave y un nodo reservados por campo, volcado después.
+//
+//   make bench            (o ./build/bench/json_tareas [tareas])
+
+#include "tareas_db.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <variant>
+
+#if __has_include("crow.h")
+#include "crow.h"
+#define JSON_TAREAS_CON_CROW 1
+#endif
+
+namespace {
+
+#ifdef JSON_TAREAS_CON_CROW
+std::string listadoArbol(const std::vector<Tarea>& tareas) {
+    crow::json::wvalue respuesta;
+    std::vector<crow::json::wvalue> lista;
+    lista.reserve(tareas.size());
+    for (const auto& tarea : tareas) {
+        crow::json::wvalue json;
+        json["id"] = tarea.id;
+        json["titulo"] = tarea.titulo;
+        json["descripcion"] = tarea.descripcion;
+        json["completada"] = tarea.completada;
+        lista.push_back(std::move(json));
+    }
+    respuesta["tareas"] = std::move(lista);
+    return respuesta.dump();
+}
+#else
+// Nodo de un árbol JSON como el de wvalue: cada objeto es un mapa con
+// claves propias y cada valor un nodo reservado aparte
+struct Nodo {
+    std::variant<std::monostate, int, bool, std::string, std::map<std::string, std::unique_ptr<Nodo>>,
+                 std::vector<Nodo>> valor;
+
+    void dump(std::string& out) const {
+        if (auto* entero = std::get_if<int>(&valor)) {
+            out += std::to_string(*entero);
+        } else if (auto* logico = std::get_if<bool>(&valor)) {
+            out += *logico ? "true" : "false";
+        } else if (auto* texto = std::get_if<std::string>(&valor)) {
+            out += '"';
+            BasicJsonWriter<std::string>::escape(*texto, out);
+            out += '"';
+        } else if (auto* objeto = std::get_if<std::map<std::string, std::unique_ptr<Nodo>>>(&valor)) {
+            out += '{';
+            bool primero = true;
+            for (const auto& [clave, nodo] : *objeto) {
+                out += primero ? "\"" : ",\"";
+                primero = false;
+                BasicJsonWriter<std::string>::escape(clave, out);
+                out += "\":";
+                nodo->dump(out);
+            }
+            out += '}';
+        } else if (auto* lista = std::get_if<std::vector<Nodo>>(&valor)) {
+            out += '[';
+            for (size_t i = 0; i < lista->size(); ++i) {
+                if (i) {
+                    out += ',';
+                }
+                (*lista)[i].dump(out);
+            }
+            out += ']';
+        } else {
+            out += "null";
+        }
+    }
+};
+
+template<typename T>
+void asignar(std::map<std::string, std::unique_ptr<Nodo>>& objeto, const char* clave, T valor) {
+    objeto[clave] = std::make_unique<Nodo>(Nodo{std::move(valor)});
+}
+
+std::string listadoArbol(const std::vector<Tarea>& tareas) {
+    std::vector<Nodo> lista;
+    lista.reserve(tareas.size());
+    for (const auto& tarea : tareas) {
+        std::map<std::string, std::unique_ptr<Nodo>> json;
+        asignar(json, "id", tarea.id);
+        asignar(json, "titulo", tarea.titulo);
+        asignar(json, "descripcion", tarea.descripcion);
+        asignar(json, "completada", tarea.completada);
+        lista.push_back(Nodo{std::move(json)});
+    }
+    std::map<std::string, std::unique_ptr<Nodo>> respuesta;
+    asignar(respuesta, "tareas", std::move(lista));
+    std::string out;
+    Nodo{std::move(respuesta)}.dump(out);
+    return out;
+}
+#endif
+
+// Como el handler de GET /api/tareas: un solo buffer, reutilizado
+void listadoDirecto(const std::vector<Tarea>& tareas, std::string& out) {
+    out.clear();
+    out += "{\"tareas\":[";
+    for (size_t i = 0; i < tareas.size(); ++i) {
+        if (i) {
+            out += ',';
+        }
+        tareas[i].appendJson(out);
+    }
+    out += "]}";
+}
+
+template<typename F>
+double nanosegundosPorTarea(size_t num_tareas, int repeticiones, F&& serializar) {
+    auto inicio = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeticiones; ++r) {
+        serializar();
+    }
+    std::chrono::duration<double, std::nano> total = std::chrono::steady_clock::now() - inicio;
+    return total.count() / (static_cast<double>(num_tareas) * repeticiones);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t num_tareas = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 1000;
+    std::vector<Tarea> tareas;
+    for (size_t i = 0; i < num_tareas; ++i) {
+        tareas.push_back({static_cast<int>(i + 1), "Tarea \"" + std::to_string(i) + "\"",
+                          "Descripción con\tcaracteres a escapar", i % 2 == 0});
+    }
+
+    std::string buffer;
+    listadoDirecto(tareas, buffer);
+    if (buffer.size() != listadoArbol(tareas).size()) {
+        std::fprintf(stderr, "Los dos serializadores no producen la misma salida\n");
+        return 1;
+    }
+
+    int repeticiones = static_cast<int>(std::max<size_t>(1, 2000000 / num_tareas));
+    double arbol = nanosegundosPorTarea(num_tareas, repeticiones, [&] {
+        std::string json = listadoArbol(tareas);
+        asm volatile("" : : "r"(json.data()) : "memory");
+    });
+    double directo = nanosegundosPorTarea(num_tareas, repeticiones, [&] {
+        listadoDirecto(tareas, buffer);
+        asm volatile("" : : "r"(buffer.data()) : "memory");
+    });
+
+#ifdef JSON_TAREAS_CON_CROW
+    const char* referencia = "crow::json::wvalue";
+#else
+    const char* referencia = "árbol (réplica de wvalue)";
+#endif
+    std::printf("Listado de %zu tareas (%zu bytes)\n", num_tareas, buffer.size());
+    std::printf("  %-26s %7.1f ns/tarea\n", referencia, arbol);
+    std::printf("  %-26s %7.1f ns/tarea  (x%.1f)\n", "Tarea::appendJson", directo, arbol / directo);
+    return 0;
+}
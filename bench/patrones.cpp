@@ -0,0 +1,78 @@
+// Validación de 1M strings con FieldOptions::pattern (email y username):
+// regex construido en cada llamada (el validador anterior), std::regex
+// compilado una vez, y FieldValidator con el patrón de la caché, que usa
+// FastPattern cuando el patrón lo permite.
+//
+//   make bench            (o ./build/bench/patrones [strings])
+
+#include "field_validator.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <regex>
+
+namespace {
+
+// Construir std::regex es tan lento que la variante anterior se mide sobre
+// una muestra y se extrapola
+constexpr size_t muestra_regex_por_llamada = 20000;
+
+template<typename F>
+double nanosegundosPorString(const std::vector<std::string>& valores, size_t cuantos, F&& valida) {
+    size_t validos = 0;
+    auto inicio = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < cuantos; ++i) {
+        validos += valida(valores[i]);
+    }
+    std::chrono::duration<double, std::nano> total = std::chrono::steady_clock::now() - inicio;
+    asm volatile("" : : "r"(validos) : "memory");
+    return total.count() / static_cast<double>(cuantos);
+}
+
+void medir(const char* nombre, const std::string& patron, const std::vector<std::string>& valores) {
+    FieldOptions<std::string> opciones;
+    opciones.pattern = patron;
+    FieldValidator<std::string> validador(nombre, opciones);
+    std::regex compilado(patron, std::regex::ECMAScript | std::regex::optimize);
+
+    double por_llamada = nanosegundosPorString(valores, std::min(valores.size(), muestra_regex_por_llamada),
+                                               [&patron](const std::string& valor) {
+        return std::regex_match(valor, std::regex(patron));
+    });
+    double regex = nanosegundosPorString(valores, valores.size(), [&compilado](const std::string& valor) {
+        return std::regex_match(valor, compilado);
+    });
+    double validado = nanosegundosPorString(valores, valores.size(), [&validador](const std::string& valor) {
+        return !validador.check(valor);
+    });
+
+    double millon = static_cast<double>(valores.size()) / 1e9;
+    std::printf("%s: %s\n", nombre, patron.c_str());
+    std::printf("  regex en cada llamada  %8.1f ns/string  %8.2f s (estimado)\n", por_llamada, por_llamada * millon);
+    std::printf("  std::regex compilado   %8.1f ns/string  %8.3f s\n", regex, regex * millon);
+    std::printf("  FieldValidator         %8.1f ns/string  %8.3f s  (x%.0f sobre el anterior, fast path: %s)\n",
+                validado, validado * millon, por_llamada / validado,
+                PatternCache::get(patron)->has_fast_path() ? "sí" : "no");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t num_strings = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 1000000;
+
+    std::vector<std::string> emails;
+    std::vector<std::string> usuarios;
+    emails.reserve(num_strings);
+    usuarios.reserve(num_strings);
+    for (size_t i = 0; i < num_strings; ++i) {
+        // Uno de cada cuatro no es válido
+        bool valido = i % 4 != 0;
+        emails.push_back("usuario." + std::to_string(i) + (valido ? "@example.com" : "@example"));
+        usuarios.push_back((valido ? "user_" : "user-") + std::to_string(i));
+    }
+
+    std::printf("%zu strings por patrón\n", num_strings);
+    medir("email", "^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\\.[a-zA-Z]{2,}$", emails);
+    medir("username", "^[a-zA-Z0-9_]{3,32}$", usuarios);
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Coste de un broadcast SSE con 100, 1k y 10k suscriptores: el
+// SSEManager anterior (formato con ostringstream y write() en cada
+// respuesta con el mutex tomado) frente a SSEManager::broadcast_event (un
+// formato y un encolado de puntero por suscriptor). El drenado lo hace
+// después la conexión en su propio hilo; aquí se mide aparte.
+//
+//   make bench            (o ./build/bench/sse_fanout)
+
+#include "sse_manager.hpp"
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <sstream>
+
+namespace {
+
+using reloj = std::chrono::steady_clock;
+
+constexpr int broadcasts = 200;
+constexpr int drenar_cada = 50;   // Los suscriptores drenan cada tantos eventos
+
+double microsegundos(reloj::time_point desde, reloj::time_point hasta) {
+    return std::chrono::duration<double, std::micro>(hasta - desde).count();
+}
+
+// Réplica del broadcast original: cada respuesta de Crow acumula el texto
+// en su buffer, como hacía write()
+double broadcastAnterior(size_t suscriptores) {
+    std::mutex clients_mutex;
+    std::vector<std::string> respuestas(suscriptores);
+
+    auto inicio = reloj::now();
+    for (int k = 0; k < broadcasts; ++k) {
+        std::ostringstream oss;
+        oss << "event: counter\ndata: " << k << "\nid: " << std::time(nullptr) << "\n\n";
+        std::string mensaje = oss.str();
+
+        std::lock_guard<std::mutex> lock(clients_mutex);
+        for (auto& respuesta : respuestas) {
+            respuesta += mensaje;
+        }
+        if (k % drenar_cada == drenar_cada - 1) {
+            for (auto& respuesta : respuestas) {
+                respuesta.clear();
+            }
+        }
+    }
+    return microsegundos(inicio, reloj::now()) / broadcasts;
+}
+
+struct Medida {
+    double publicar_us;     // Por broadcast
+    double drenar_us;       // Por broadcast, sumando todas las conexiones
+};
+
+Medida broadcastActual(size_t suscriptores) {
+    SSEManager manager({256, OverflowPolicy::DropOldest});
+    std::vector<std::shared_ptr<SseSubscriber>> conexiones;
+    conexiones.reserve(suscriptores);
+    for (size_t i = 0; i < suscriptores; ++i) {
+        conexiones.push_back(manager.subscribe([](const std::shared_ptr<SseSubscriber>&) {}));
+    }
+
+    std::string escrito;
+    reloj::duration publicar{};
+    reloj::duration drenar{};
+    for (int k = 0; k < broadcasts; ++k) {
+        auto inicio = reloj::now();
+        manager.broadcast_event("counter", std::to_string(k));
+        publicar += reloj::now() - inicio;
+
+        if (k % drenar_cada == drenar_cada - 1) {
+            inicio = reloj::now();
+            for (const auto& conexion : conexiones) {
+                conexion->drain([&escrito](const std::string& texto) {
+                    escrito.assign(texto);
+                });
+            }
+            drenar += reloj::now() - inicio;
+        }
+    }
+
+    auto por_broadcast = [](reloj::duration total) {
+        return std::chrono::duration<double, std::micro>(total).count() / broadcasts;
+    };
+    return {por_broadcast(publicar), por_broadcast(drenar)};
+}
+
+} // namespace
+
+int main() {
+    std::printf("%-13s %16s %16s %14s %16s\n", "suscriptores", "anterior us", "publicar us",
+                "ns/suscriptor", "drenado us");
+    for (size_t suscriptores : {size_t{100}, size_t{1000}, size_t{10000}}) {
+        double anterior = broadcastAnterior(suscriptores);
+        Medida actual = broadcastActual(suscriptores);
+        std::printf("%-13zu %16.2f %16.2f %14.1f %16.2f\n", suscriptores, anterior, actual.publicar_us,
+                    actual.publicar_us * 1000.0 / static_cast<double>(suscriptores), actual.drenar_us);
+    }
+    std::printf("(anterior: con el mutex global tomado; publicar: lo que bloquea al que publica;\n"
+                " drenado: lo que reparten después los hilos de las conexiones)\n");
+    return 0;
+}
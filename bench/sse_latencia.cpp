@@ -0,0 +1,165 @@
+// Latencia de extremo a extremo de un evento SSE: desde post() en un hilo
+// productor hasta que su texto llega al buffer de escritura de la conexión.
+// Recorre el camino del servidor: MpscQueue, hilo de SseDispatcher,
+// publish_batch, despertar del suscriptor, drenado en el hilo de E/S (una
+// cola con mutex y condition_variable en lugar de asio::post). No incluye
+// el socket ni Crow. Cada evento lleva en 'data' su instante de publicación.
+//
+//   make bench    (o ./build/bench/sse_latencia [productores] [us entre eventos] [suscriptores])
+
+#include "sse_dispatcher.hpp"
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <future>
+#include <functional>
+
+namespace {
+
+using reloj = std::chrono::steady_clock;
+
+int64_t ahoraNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(reloj::now().time_since_epoch()).count();
+}
+
+// Hilo de E/S mínimo: ejecuta en orden las tareas que se le encolan
+class BucleEs {
+public:
+    BucleEs() : hilo_([this] { ejecutar(); }) {}
+
+    ~BucleEs() {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            fin_ = true;
+        }
+        cv_.notify_one();
+        hilo_.join();
+    }
+
+    void post(std::function<void()> tarea) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            tareas_.push_back(std::move(tarea));
+        }
+        cv_.notify_one();
+    }
+
+private:
+    void ejecutar() {
+        std::unique_lock<std::mutex> lock(mtx_);
+        while (true) {
+            cv_.wait(lock, [this] { return fin_ || !tareas_.empty(); });
+            if (tareas_.empty()) {
+                return;
+            }
+            auto tarea = std::move(tareas_.front());
+            tareas_.pop_front();
+            lock.unlock();
+            tarea();
+            lock.lock();
+        }
+    }
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> tareas_;
+    bool fin_ = false;
+    std::thread hilo_;
+};
+
+struct Escenario {
+    const char* nombre;
+    int productores;
+    std::chrono::microseconds intervalo;   // Entre eventos de un mismo productor
+    std::chrono::milliseconds duracion;
+};
+
+void medir(const Escenario& escenario, int suscriptores) {
+    SseOptions opciones;
+    opciones.queue_capacity = 4096;
+    SSEManager manager(opciones);
+    BucleEs es;
+
+    // La sonda anota la latencia de cada evento que drena
+    std::vector<int64_t> latencias;
+    latencias.reserve(1 << 20);
+    auto sonda = manager.subscribe([&es, &latencias](const std::shared_ptr<SseSubscriber>& suscriptor) {
+        es.post([suscriptor, &latencias] {
+            suscriptor->drain([&latencias](const std::string& texto) {
+                int64_t llegada = ahoraNs();
+                for (size_t pos = texto.find("data: "); pos != std::string::npos; pos = texto.find("data: ", pos)) {
+                    pos += 6;
+                    int64_t publicado = 0;
+                    std::from_chars(texto.data() + pos, texto.data() + texto.size(), publicado);
+                    latencias.push_back(llegada - publicado);
+                }
+            });
+        });
+    }, {"bench"});
+
+    // El resto de conexiones solo añade trabajo de fan-out
+    std::vector<std::shared_ptr<SseSubscriber>> resto;
+    for (int i = 0; i < suscriptores - 1; ++i) {
+        resto.push_back(manager.subscribe([&es](const std::shared_ptr<SseSubscriber>& suscriptor) {
+            es.post([suscriptor] {
+                suscriptor->drain([](const std::string&) {});
+            });
+        }, {"bench"}));
+    }
+
+    SseDispatcher despachador(manager);
+    std::atomic<bool> seguir{true};
+    std::vector<std::thread> productores;
+    for (int p = 0; p < escenario.productores; ++p) {
+        productores.emplace_back([&] {
+            while (seguir.load(std::memory_order_relaxed)) {
+                despachador.post("bench", "latencia", std::to_string(ahoraNs()));
+                std::this_thread::sleep_for(escenario.intervalo);
+            }
+        });
+    }
+    std::this_thread::sleep_for(escenario.duracion);
+    seguir = false;
+    for (auto& productor : productores) {
+        productor.join();
+    }
+    despachador.stop();
+
+    // Que el hilo de E/S termine lo pendiente antes de leer las latencias
+    std::promise<void> vaciado;
+    es.post([&vaciado] { vaciado.set_value(); });
+    vaciado.get_future().wait();
+
+    if (latencias.empty()) {
+        std::printf("%-28s sin eventos\n", escenario.nombre);
+        return;
+    }
+    std::sort(latencias.begin(), latencias.end());
+    auto percentil = [&latencias](double q) {
+        size_t i = std::min(latencias.size() - 1, static_cast<size_t>(q * static_cast<double>(latencias.size())));
+        return static_cast<double>(latencias[i]) / 1000.0;
+    };
+    SseDispatcher::Stats stats = despachador.stats();
+    std::printf("%-28s %8zu eventos %7lu lotes  p50 %7.1f  p90 %7.1f  p99 %8.1f  p99.9 %8.1f  máx %8.1f us\n",
+                escenario.nombre, latencias.size(), static_cast<unsigned long>(stats.batches), percentil(0.5),
+                percentil(0.9), percentil(0.99), percentil(0.999), static_cast<double>(latencias.back()) / 1000.0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int productores = argc > 1 ? std::atoi(argv[1]) : 4;
+    int intervalo_us = argc > 2 ? std::atoi(argv[2]) : 20;
+    int suscriptores = argc > 3 ? std::atoi(argv[3]) : 100;
+
+    std::printf("Latencia post() -> buffer de la conexión, %d suscriptores (%u núcleos)\n", suscriptores,
+                std::thread::hardware_concurrency());
+    medir({"carga (productores en bucle)", productores, std::chrono::microseconds(intervalo_us),
+           std::chrono::milliseconds(2000)}, suscriptores);
+    medir({"esporádico (1 cada 500 us)", 1, std::chrono::microseconds(500), std::chrono::milliseconds(1000)},
+          suscriptores);
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Lecturas y escrituras concurrentes sobre TareasDB (mezclas 95/5 y 50/50)
+// frente al almacén anterior: un std::vector con un único std::mutex y
+// búsquedas lineales por id.
+//
+//   make bench            (o ./build/bench/tareas_db [hilos])
+
+#include "tareas_db.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+namespace {
+
+// Réplica del TareasDB original, como referencia
+class TareasDBAnterior {
+public:
+    void crear(std::string titulo, std::string descripcion) {
+        std::lock_guard<std::mutex> lock(mtx);
+        tareas.push_back({siguiente_id++, std::move(titulo), std::move(descripcion), false});
+    }
+
+    std::optional<Tarea> obtenerPorId(int id) {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (const auto& tarea : tareas) {
+            if (tarea.id == id) {
+                return tarea;
+            }
+        }
+        return std::nullopt;
+    }
+
+    bool actualizar(int id, std::string titulo, std::string descripcion, bool completada) {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (auto& tarea : tareas) {
+            if (tarea.id == id) {
+                tarea.titulo = std::move(titulo);
+                tarea.descripcion = std::move(descripcion);
+                tarea.completada = completada;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::vector<Tarea> tareas;
+    std::mutex mtx;
+    int siguiente_id = 1;
+};
+
+constexpr int num_tareas = 10000;
+constexpr int operaciones_por_hilo = 200000;
+
+// Millones de operaciones por segundo con 'hilos' hilos y un
+// 'porcentaje_lecturas' % de obtenerPorId; el resto son actualizar
+template<typename DB>
+double medir(DB& db, int porcentaje_lecturas, unsigned hilos) {
+    std::vector<std::thread> trabajadores;
+    auto inicio = std::chrono::steady_clock::now();
+    for (unsigned h = 0; h < hilos; ++h) {
+        trabajadores.emplace_back([&db, porcentaje_lecturas, h] {
+            std::mt19937 rng(h + 1);
+            for (int i = 0; i < operaciones_por_hilo; ++i) {
+                int id = static_cast<int>(rng() % num_tareas) + 1;
+                if (static_cast<int>(rng() % 100) < porcentaje_lecturas) {
+                    auto tarea = db.obtenerPorId(id);
+                    asm volatile("" : : "r"(&tarea) : "memory");
+                } else {
+                    db.actualizar(id, "titulo", "descripcion", true);
+                }
+            }
+        });
+    }
+    for (auto& trabajador : trabajadores) {
+        trabajador.join();
+    }
+    std::chrono::duration<double> segundos = std::chrono::steady_clock::now() - inicio;
+    return hilos * static_cast<double>(operaciones_por_hilo) / segundos.count() / 1e6;
+}
+
+template<typename DB>
+double medirMezcla(int porcentaje_lecturas, unsigned hilos) {
+    DB db;
+    for (int i = 0; i < num_tareas; ++i) {
+        db.crear("titulo", "descripcion");
+    }
+    return medir(db, porcentaje_lecturas, hilos);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned hilos = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1]))
+                              : std::max(4u, std::thread::hardware_concurrency());
+    std::printf("TareasDB: %d tareas, %u hilos, %d operaciones por hilo (%u núcleos)\n",
+                num_tareas, hilos, operaciones_por_hilo, std::thread::hardware_concurrency());
+
+    for (int lecturas : {95, 50}) {
+        double anterior = medirMezcla<TareasDBAnterior>(lecturas, hilos);
+        double actual = medirMezcla<TareasDB>(lecturas, hilos);
+        std::printf("  mezcla %2d/%-2d  anterior %7.2f Mops/s  shards %7.2f Mops/s  (x%.1f)\n",
+                    lecturas, 100 - lecturas, anterior, actual, actual / anterior);
+    }
+    return 0;
+}
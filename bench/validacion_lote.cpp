@@ -0,0 +1,75 @@
+// Validación de importaciones masivas: BaseModel::validate_batch (recorre
+// campo a campo todos los objetos) frente al bucle de validate() por
+// objeto, con 1k, 100k y 1M objetos y un 10% de objetos inválidos.
+//
+//   make bench            (o ./build/bench/validacion_lote)
+
+#include "base_model.hpp"
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+class ImportacionModel : public BaseModel<ImportacionModel>
+{
+public:
+    Field<std::string> titulo = CreateField<std::string>("titulo", true, 3, 80);
+    Field<std::string> codigo = CreateField<std::string>("codigo", true, 4, 12);
+    Field<int> prioridad = CreateField<int>("prioridad", true, 1, 5);
+    Field<int> estimacion = CreateField<int>("estimacion", true, 0, 1000);
+    Field<double> peso = CreateField<double>("peso", true, 0.0, 1.0);
+
+    REGISTER_FIELDS(titulo, codigo, prioridad, estimacion, peso)
+};
+
+std::vector<ImportacionModel> generar(size_t cuantos) {
+    std::vector<ImportacionModel> modelos(cuantos);
+    for (size_t i = 0; i < cuantos; ++i) {
+        ImportacionModel& modelo = modelos[i];
+        modelo.titulo = "Tarea importada " + std::to_string(i);
+        modelo.codigo = "IMP-" + std::to_string(i % 10000);
+        modelo.prioridad = static_cast<int>(i % 5) + 1;
+        modelo.estimacion = static_cast<int>(i % 1000);
+        modelo.peso = static_cast<double>(i % 100) / 100.0;
+        if (i % 10 == 0) {
+            modelo.prioridad = 9;  // Fuera de rango
+        }
+    }
+    return modelos;
+}
+
+template<typename F>
+double milisegundos(F&& f) {
+    auto inicio = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> total = std::chrono::steady_clock::now() - inicio;
+    return total.count();
+}
+
+} // namespace
+
+int main() {
+    std::printf("%-9s %14s %14s %9s\n", "objetos", "validate() ms", "batch ms", "mejora");
+    for (size_t cuantos : {size_t{1000}, size_t{100000}, size_t{1000000}}) {
+        std::vector<ImportacionModel> modelos = generar(cuantos);
+
+        size_t fallos_uno = 0;
+        double uno = milisegundos([&] {
+            for (auto& modelo : modelos) {
+                fallos_uno += !modelo.validate().valid();
+            }
+        });
+
+        size_t fallos_lote = 0;
+        double lote = milisegundos([&] {
+            fallos_lote = ImportacionModel::validate_batch(modelos).failed_count();
+        });
+
+        if (fallos_uno != fallos_lote) {
+            std::fprintf(stderr, "Resultados distintos: %zu frente a %zu\n", fallos_uno, fallos_lote);
+            return 1;
+        }
+        std::printf("%-9zu %14.2f %14.2f %8.1fx\n", cuantos, uno, lote, uno / lote);
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Fan-out de mensajes WebSocket con 1k, 10k y 50k conexiones en una sala:
+// el servidor original (un std::mutex global y un unordered_set con todas
+// las conexiones, enviando con el mutex tomado) frente a Salas, con varios
+// hilos publicando a la vez. También mide cuánto tarda una alta+baja en la
+// sala mientras los envíos están en marcha. La conexión imita a Crow:
+// send_text copia el mensaje y lo encola tras su cabecera.
+//
+//   make bench            (o ./build/bench/ws_fanout [hilos])
+
+#include "salas.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unordered_set>
+
+namespace {
+
+using reloj = std::chrono::steady_clock;
+
+struct Conexion {
+    std::mutex mtx;
+    std::vector<std::string> cola;
+
+    void send_text(const std::string& mensaje) {
+        std::string cabecera(2, '\x81');
+        std::lock_guard<std::mutex> lock(mtx);
+        if (cola.size() >= 64) {
+            cola.clear();  // El socket ya lo habría enviado
+        }
+        cola.push_back(std::move(cabecera));
+        cola.push_back(mensaje);
+    }
+};
+
+struct Anterior {
+    std::mutex mtx;
+    std::unordered_set<Conexion*> users;
+
+    void broadcast(const std::string& mensaje) {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (auto* user : users) {
+            user->send_text(mensaje);
+        }
+    }
+
+    void altaYBaja(Conexion* extra) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            users.insert(extra);
+        }
+        std::lock_guard<std::mutex> lock(mtx);
+        users.erase(extra);
+    }
+};
+
+struct ConSalas {
+    Salas<Conexion> salas;
+
+    void broadcast(const std::string& mensaje) {
+        salas.publicar("general", [&mensaje](Conexion& conexion) {
+            conexion.send_text(mensaje);
+        });
+    }
+
+    void altaYBaja(Conexion* extra) {
+        salas.unir("general", extra);
+        salas.salir("general", extra);
+    }
+};
+
+struct Resultado {
+    double entregas_por_segundo;
+    double alta_baja_media_us;
+    double alta_baja_max_us;
+};
+
+// 'hilos' publican sin parar durante 'duracion' mientras el hilo principal
+// hace altas y bajas cada poco
+template<typename Servidor>
+Resultado medir(Servidor& servidor, size_t conexiones, unsigned hilos, std::chrono::milliseconds duracion) {
+    const std::string mensaje(64, 'x');
+    std::atomic<bool> seguir{true};
+    std::atomic<uint64_t> broadcasts{0};
+    std::vector<std::thread> publicadores;
+    auto inicio = reloj::now();
+    for (unsigned h = 0; h < hilos; ++h) {
+        publicadores.emplace_back([&] {
+            while (seguir.load(std::memory_order_relaxed)) {
+                servidor.broadcast(mensaje);
+                broadcasts.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    Conexion extra;
+    std::vector<double> esperas;
+    while (reloj::now() - inicio < duracion) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        auto antes = reloj::now();
+        servidor.altaYBaja(&extra);
+        esperas.push_back(std::chrono::duration<double, std::micro>(reloj::now() - antes).count());
+    }
+    seguir = false;
+    for (auto& publicador : publicadores) {
+        publicador.join();
+    }
+    std::chrono::duration<double> segundos = reloj::now() - inicio;
+
+    double media = 0;
+    for (double espera : esperas) {
+        media += espera;
+    }
+    media /= static_cast<double>(std::max<size_t>(1, esperas.size()));
+    double maximo = esperas.empty() ? 0 : *std::max_element(esperas.begin(), esperas.end());
+    return {static_cast<double>(broadcasts.load()) * static_cast<double>(conexiones) / segundos.count(), media, maximo};
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned hilos = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1]))
+                              : std::max(2u, std::thread::hardware_concurrency());
+    std::printf("Fan-out WebSocket: %u hilos publicando (%u núcleos), mensajes de 64 bytes\n", hilos,
+                std::thread::hardware_concurrency());
+    std::printf("%-10s %-8s %16s %18s %16s\n", "conexiones", "servidor", "M entregas/s", "alta+baja media us",
+                "alta+baja máx us");
+
+    for (size_t conexiones : {size_t{1000}, size_t{10000}, size_t{50000}}) {
+        std::vector<Conexion> sockets(conexiones);
+
+        Anterior anterior;
+        ConSalas con_salas;
+        for (auto& socket : sockets) {
+            anterior.users.insert(&socket);
+            con_salas.salas.unir("general", &socket);
+        }
+
+        auto duracion = std::chrono::milliseconds(1000);
+        Resultado a = medir(anterior, conexiones, hilos, duracion);
+        Resultado s = medir(con_salas, conexiones, hilos, duracion);
+        std::printf("%-10zu %-8s %16.2f %18.1f %16.1f\n", conexiones, "anterior", a.entregas_por_segundo / 1e6,
+                    a.alta_baja_media_us, a.alta_baja_max_us);
+        std::printf("%-10zu %-8s %16.2f %18.1f %16.1f\n", conexiones, "salas", s.entregas_por_segundo / 1e6,
+                    s.alta_baja_media_us, s.alta_baja_max_us);
+    }
+    return 0;
+}
@@ -5,116 +5,416 @@
 #include "field_validator.hpp"
 #include "field_registry.hpp"
 #include <typeindex>
+#include <algorithm>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <memory_resource>
+#include <iterator>
+#include <bit>
+#include <cstdint>
+#include <exception>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
-// Flag para evitar recursión durante el registro
-inline thread_local bool in_registration = false;
+// Resultado de BaseModel::validate: errores compactos por campo más los
+// mensajes de custom_validate()
+class ValidationResult {
+public:
+    explicit ValidationResult(const std::vector<FieldInfo>& fields,
+                              std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : fields_(&fields), errors_(resource) {}
+
+    bool valid() const {
+        return errors_.empty() && custom_errors_.empty();
+    }
+
+    explicit operator bool() const {
+        return valid();
+    }
+
+    const std::pmr::vector<ValidationError>& errors() const {
+        return errors_;
+    }
+
+    // Formatea los mensajes legibles (solo se llama cuando hay que mostrarlos)
+    std::vector<std::string> messages() const {
+        std::vector<std::string> result;
+        result.reserve(errors_.size() + custom_errors_.size());
+        for (const auto& error : errors_) {
+            result.push_back((*fields_)[error.field_index].validator->format_error(error));
+        }
+        result.insert(result.end(), custom_errors_.begin(), custom_errors_.end());
+        return result;
+    }
+
+    void add(const ValidationError& error) {
+        errors_.push_back(error);
+    }
+
+    void add_custom(std::vector<std::string> errors) {
+        if (!errors.empty()) {
+            custom_errors_.insert(custom_errors_.end(),
+                                  std::make_move_iterator(errors.begin()),
+                                  std::make_move_iterator(errors.end()));
+        }
+    }
+
+private:
+    const std::vector<FieldInfo>* fields_;
+    std::pmr::vector<ValidationError> errors_;
+    std::vector<std::string> custom_errors_;
+};
+
+// Resultado de BaseModel::validate_batch: un bit por objeto, activo si el
+// objeto incumple alguna regla. Para conocer los errores concretos de un
+// objeto basta con llamar a su validate().
+class BatchValidationResult {
+public:
+    explicit BatchValidationResult(size_t count) : count_(count), bits_((count + 63) / 64, 0) {}
+
+    size_t size() const {
+        return count_;
+    }
+
+    bool failed(size_t index) const {
+        return (bits_[index / 64] >> (index % 64)) & 1;
+    }
+
+    size_t failed_count() const {
+        size_t total = 0;
+        for (uint64_t word : bits_) {
+            total += static_cast<size_t>(std::popcount(word));
+        }
+        return total;
+    }
+
+    bool all_valid() const {
+        for (uint64_t word : bits_) {
+            if (word != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void mark_failed(size_t index) {
+        bits_[index / 64] |= uint64_t{1} << (index % 64);
+    }
+
+    // Palabras del bitmap (el bit i % 64 de la palabra i / 64 es el objeto i)
+    const std::vector<uint64_t>& words() const {
+        return bits_;
+    }
+
+    uint64_t* data() {
+        return bits_.data();
+    }
+
+private:
+    size_t count_;
+    std::vector<uint64_t> bits_;
+};
 
-// BaseModel usando CRTP
+// BaseModel usando CRTP. No tiene métodos virtuales: los modelos no llevan
+// vtable y todo lo que depende de Derived se resuelve en compilación.
 template<typename Derived>
 class BaseModel {
 public:
+    using model_type = Derived;
+
     BaseModel() {
         if (!in_registration) {
             ensure_fields_registered();
         }
     }
 
-    virtual ~BaseModel() = default;
+    // Validar todos los campos. Los campos se recorren en compilación a
+    // partir de Derived::field_members(), así que cada comprobación es una
+    // llamada directa a FieldValidator<T>::check que el compilador puede
+    // inlinear. Si todo es correcto no se reserva memoria; los mensajes se
+    // generan solo al llamar a ValidationResult::messages(). Los errores se
+    // guardan en 'resource' (p. ej. la arena de la petición).
+    ValidationResult validate(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+        const auto& fields = schema().fields();
+        ValidationResult result(fields, resource);
+        Derived& self = static_cast<Derived&>(*this);
 
-    // Validar todos los campos
-    std::pair<bool, std::vector<std::string>> validate() {
-        ensure_fields_registered();
-        
-        std::vector<std::string> errors;
-        auto& registry = FieldRegistry::instance();
-        const auto& fields = registry.get_fields(std::type_index(typeid(Derived)));
-        
-        for (const auto& field_info : fields) {
-            void* field_ptr = reinterpret_cast<char*>(this) + field_info.offset;
-            
-            if (field_info.validate_func) {
-                auto [valid, error] = field_info.validate_func(field_ptr);
-                if (!valid) {
-                    errors.push_back(error);
+        constexpr size_t field_count = std::tuple_size_v<decltype(Derived::field_members())>;
+        check_fields(self, fields, result, std::make_index_sequence<field_count>{});
+        result.add_custom(self.custom_validate());
+
+        return result;
+    }
+
+    // Valida un lote de objetos recorriéndolo por campos: cada regla se
+    // aplica a todos los objetos antes de pasar al siguiente campo, sin
+    // std::function ni llamadas virtuales por objeto. custom_validate() solo
+    // se invoca si el modelo lo redefine, y solo sobre los objetos que han
+    // superado las reglas de campo.
+    static BatchValidationResult validate_batch(std::span<Derived> models) {
+        BatchValidationResult result(models.size());
+        if (models.empty()) {
+            return result;
+        }
+
+        // Por bloques que caben en la caché: con lotes grandes, recorrer todos
+        // los objetos una vez por campo los traería de memoria en cada pasada.
+        // Los bloques son múltiplos de 64 objetos para escribir palabras
+        // enteras del bitmap.
+        constexpr size_t block_bytes = 64 * 1024;
+        constexpr size_t block = std::max<size_t>(64, block_bytes / sizeof(Derived) / 64 * 64);
+
+        const char* first = reinterpret_cast<const char*>(models.data());
+        for (size_t start = 0; start < models.size(); start += block) {
+            size_t count = std::min(block, models.size() - start);
+            const char* block_first = first + start * sizeof(Derived);
+            for (const FieldInfo& field_info : schema().fields()) {
+                if (field_info.batch_func && field_info.validator) {
+                    field_info.batch_func(*field_info.validator, block_first + field_info.offset, sizeof(Derived),
+                                          count, result.data() + start / 64);
+                }
+            }
+        }
+
+        // &Derived::custom_validate solo es de tipo miembro de Derived si lo redefine
+        using CustomValidate = decltype(&Derived::custom_validate);
+        if constexpr (!std::is_same_v<CustomValidate, decltype(&BaseModel::custom_validate)>) {
+            for (size_t i = 0; i < models.size(); ++i) {
+                if (!result.failed(i) && !models[i].custom_validate().empty()) {
+                    result.mark_failed(i);
                 }
             }
         }
-        
-        auto custom_errors = custom_validate();
-        errors.insert(errors.end(), custom_errors.begin(), custom_errors.end());
-        
-        return {errors.empty(), errors};
+
+        return result;
+    }
+
+    // Carga los campos desde un JSON en una sola pasada, sin DOM intermedio:
+    // cada valor se lee directamente sobre su Field<T> usando el offset y el
+    // parser registrados. Las claves desconocidas se ignoran. El estado
+    // temporal del parser se reserva en 'resource'.
+    std::pair<bool, std::string> from_json(std::string_view json,
+                                           std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+        const ModelSchema& model_schema = schema();
+        const auto& fields = model_schema.fields();
+        std::pmr::vector<bool> seen(fields.size(), false, resource);
+        char* base = reinterpret_cast<char*>(static_cast<Derived*>(this));
+
+        JsonReader reader(json);
+        if (!reader.begin_object()) {
+            return {false, "Invalid JSON: expected an object"};
+        }
+
+        std::string_view key;
+        while (reader.next_member(key)) {
+            size_t index = model_schema.index_of(key);
+            if (index == fields.size()) {
+                if (!reader.skip_value()) {
+                    break;
+                }
+                continue;
+            }
+
+            // null equivale a no enviar el campo
+            if (reader.read_null()) {
+                continue;
+            }
+
+            const FieldInfo& field_info = fields[index];
+            if (!field_info.parse_func || !field_info.parse_func(base + field_info.offset, reader)) {
+                return {false, "Field '" + field_info.name + "' has an invalid value"};
+            }
+            seen[index] = true;
+        }
+
+        if (reader.failed() || !reader.at_end()) {
+            return {false, "Invalid JSON"};
+        }
+
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (!seen[i] && fields[i].validator && fields[i].validator->is_required()) {
+                return {false, "Field '" + fields[i].name + "' is required"};
+            }
+        }
+
+        return {true, ""};
+    }
+
+    // Serializa los campos al final de 'out'. Cada campo se escribe con el
+    // writer de su tipo y su clave ya escapada, ambos fijados al registrar.
+    void to_json(std::string& out) const {
+        const auto& fields = schema().fields();
+        const char* base = reinterpret_cast<const char*>(static_cast<const Derived*>(this));
+
+        out.push_back('{');
+        bool first = true;
+        for (const auto& field_info : fields) {
+            if (!field_info.write_func) {
+                continue;
+            }
+            if (!first) {
+                out.push_back(',');
+            }
+            first = false;
+            out.append(field_info.json_key);
+            field_info.write_func(base + field_info.offset, out);
+        }
+        out.push_back('}');
     }
 
     const std::vector<FieldInfo>& get_fields() const {
-        ensure_fields_registered();
-        auto& registry = FieldRegistry::instance();
-        return registry.get_fields(std::type_index(typeid(Derived)));
+        return schema().fields();
     }
 
-    bool has_field(const std::string& field_name) const {
-        ensure_fields_registered();
-        auto& registry = FieldRegistry::instance();
-        return registry.get_field(std::type_index(typeid(Derived)), field_name) != nullptr;
+    bool has_field(std::string_view field_name) const {
+        return schema().find(field_name) != nullptr;
     }
 
-    const FieldInfo* get_field_info(const std::string& field_name) const {
-        ensure_fields_registered();
-        auto& registry = FieldRegistry::instance();
-        return registry.get_field(std::type_index(typeid(Derived)), field_name);
+    const FieldInfo* get_field_info(std::string_view field_name) const {
+        return schema().find(field_name);
     }
 
-    virtual std::vector<std::string> custom_validate() {
+    // Punteros a miembro de los campos del modelo; REGISTER_FIELDS los
+    // redefine en Derived
+    static constexpr auto field_members() {
+        return std::tuple<>{};
+    }
+
+    // Esquema del modelo, construido una sola vez. La inicialización de un
+    // static local es thread-safe desde C++11: si varios workers llegan a la
+    // vez, solo uno registra y el resto espera; después de la primera vez el
+    // coste es una simple lectura con acquire (sin mutex ni RMW atómico).
+    static const ModelSchema& schema() {
+        static const ModelSchema instance(register_fields());
+        return instance;
+    }
+
+    // Validación adicional del modelo completo: Derived puede ocultarla con
+    // su propia versión (no es virtual)
+    std::vector<std::string> custom_validate() {
         return {};
     }
 
 protected:
-    void ensure_fields_registered() const {
-        static bool registered = false;
-        
-        if (!registered) {
-            register_fields();
-            registered = true;
-        }
+    ~BaseModel() = default;
+
+    static void ensure_fields_registered() {
+        schema();
     }
     
-    // Método virtual que devuelve punteros a los campos
-    virtual std::vector<void*> get_field_pointers() { return {}; }
-    
-    // Template helper para registrar un campo (público para que la macro pueda usarlo)
+    // Template helper para registrar un campo
     template<typename T>
-    static void register_single_field(Derived* instance, Field<T>* field) {
-        size_t offset = reinterpret_cast<char*>(field) - 
-                       reinterpret_cast<char*>(instance);
+    static void register_single_field(Derived* instance, const Field<T>* field) {
+        size_t offset = reinterpret_cast<const char*>(field) - 
+                       reinterpret_cast<const char*>(instance);
         field->register_in_registry(std::type_index(typeid(Derived)), offset);
     }
 
 private:
-    static void register_fields() {
-        in_registration = true;
-        
-        // Crear instancia temporal
+    // El campo I del esquema es el elemento I de field_members(): ambos
+    // siguen el orden de REGISTER_FIELDS
+    template<size_t... I>
+    static void check_fields([[maybe_unused]] const Derived& self,
+                             [[maybe_unused]] const std::vector<FieldInfo>& fields,
+                             [[maybe_unused]] ValidationResult& result, std::index_sequence<I...>) {
+        [[maybe_unused]] constexpr auto members = Derived::field_members();
+        (check_field<I>((self.*std::get<I>(members)).value(), fields[I], result), ...);
+    }
+
+    template<size_t I, typename T>
+    static void check_field(const T& value, const FieldInfo& field_info, ValidationResult& result) {
+        ValidationError error = static_cast<const FieldValidator<T>&>(*field_info.validator).check(value);
+        if (error) {
+            error.field_index = static_cast<uint32_t>(I);
+            result.add(error);
+        }
+    }
+
+    // Estado de registro del hilo mientras se construye la instancia
+    // temporal. Se restaura aunque el registro falle (p. ej. un pattern
+    // inválido lanza desde FieldValidator): si no, el hilo seguiría "en
+    // registro" y las siguientes instancias no registrarían nada. Si falla,
+    // se descarta lo registrado a medias para que el reintento empiece de cero.
+    struct RegistrationGuard {
+        int uncaught = std::uncaught_exceptions();
+
+        RegistrationGuard() {
+            in_registration = true;
+            pending_fields.clear();
+        }
+
+        ~RegistrationGuard() {
+            in_registration = false;
+            pending_fields.clear();
+            if (std::uncaught_exceptions() > uncaught) {
+                FieldRegistry::instance().clear_model(std::type_index(typeid(Derived)));
+            }
+        }
+    };
+
+    // Solo se ejecuta una vez por modelo, dentro de la inicialización de schema()
+    static std::vector<FieldInfo> register_fields() {
+        constexpr auto members = Derived::field_members();
+        constexpr size_t field_count = std::tuple_size_v<decltype(members)>;
+
+        RegistrationGuard guard;
+
+        // Crear instancia temporal y registrar sus campos (nombre, validador
+        // y offset) en el registro en tiempo de ejecución
         Derived temp_instance;
-        
-        // Llamar a get_field_pointers para triggerar el registro
-        temp_instance.get_field_pointers();
-        
-        in_registration = false;
+        std::apply([&temp_instance](auto... member) {
+            (register_single_field(&temp_instance, &(temp_instance.*member)), ...);
+        }, members);
+
+        // check_fields() indexa el esquema con la posición en field_members():
+        // cada miembro debe haber dejado exactamente un campo. Un miembro
+        // listado dos veces solo registra uno y se detecta aquí, al arrancar
+        // (register_models), en lugar de leer fuera del esquema al validar.
+        std::vector<FieldInfo> fields = FieldRegistry::instance().get_fields(std::type_index(typeid(Derived)));
+        if (fields.size() != field_count) {
+            throw std::logic_error(std::string("REGISTER_FIELDS de ") + typeid(Derived).name() +
+                                   ": los campos registrados no coinciden con los listados");
+        }
+
+        // Copia contigua e inmutable de los campos para el hot path
+        return fields;
     }
 };
 
-// Macro mínima para registrar campos
+// Registra de forma anticipada el esquema de varios modelos (p. ej. al
+// arrancar, antes de lanzar los workers), para que la primera petición no
+// pague la construcción de la instancia temporal.
+template<typename... Models>
+void register_models() {
+    (Models::schema(), ...);
+}
+
+// Aplica m a cada argumento, separando los resultados con comas. Cada
+// nivel de MODEL_EXPAND vuelve a examinar la lista y avanza un argumento:
+// 4^4 = 256 pasadas como mínimo, así que admite al menos 256 campos por
+// modelo (pasado el límite, el error menciona MODEL_FOR_EACH_AGAIN).
+#define MODEL_PARENS ()
+#define MODEL_EXPAND(...) MODEL_EXPAND4(MODEL_EXPAND4(MODEL_EXPAND4(MODEL_EXPAND4(__VA_ARGS__))))
+#define MODEL_EXPAND4(...) MODEL_EXPAND3(MODEL_EXPAND3(MODEL_EXPAND3(MODEL_EXPAND3(__VA_ARGS__))))
+#define MODEL_EXPAND3(...) MODEL_EXPAND2(MODEL_EXPAND2(MODEL_EXPAND2(MODEL_EXPAND2(__VA_ARGS__))))
+#define MODEL_EXPAND2(...) MODEL_EXPAND1(MODEL_EXPAND1(MODEL_EXPAND1(MODEL_EXPAND1(__VA_ARGS__))))
+#define MODEL_EXPAND1(...) __VA_ARGS__
+#define MODEL_FOR_EACH(m, ...) __VA_OPT__(MODEL_EXPAND(MODEL_FOR_EACH_STEP(m, __VA_ARGS__)))
+#define MODEL_FOR_EACH_STEP(m, x, ...) m(x) __VA_OPT__(, MODEL_FOR_EACH_AGAIN MODEL_PARENS (m, __VA_ARGS__))
+#define MODEL_FOR_EACH_AGAIN() MODEL_FOR_EACH_STEP
+
+#define MODEL_FIELD_MEMBER(field) &model_type::field
+
+// Macro mínima para registrar campos: define la tupla de punteros a miembro
+// que usan validate() y el registro del esquema
 #define REGISTER_FIELDS(...) \
-    std::vector<void*> get_field_pointers() override { \
-        register_fields_impl(__VA_ARGS__); \
-        return {}; \
-    } \
-    template<typename... Fields> \
-    void register_fields_impl(Fields&... fields) { \
-        (register_single_field(this, &fields), ...); \
+    static constexpr auto field_members() { \
+        return std::make_tuple(MODEL_FOR_EACH(MODEL_FIELD_MEMBER, __VA_ARGS__)); \
     }
 
 #endif // BASE_MODEL_HPP
\ No newline at end of file
@@ -1,161 +1,367 @@
 #include "crow.h"
 #include <unordered_set>
+#include <unordered_map>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <array>
+#include <optional>
+#include <charconv>
+#include <variant>
+#include <vector>
+#include <cstdint>
 
 // ============================================================================
 // Sistema de rutas anónimas
 // ============================================================================
 
-class AnonymousRouteRegistry
+// Tipos de parámetro soportados en los patrones (<int>, <uint>, ...)
+enum class RouteParamKind : uint8_t
 {
-private:
-    std::unordered_set<std::string> anonymous_routes_;
-    static AnonymousRouteRegistry &instance()
+    Int,
+    UInt,
+    Double,
+    String,
+    Path,
+    Count
+};
+
+// Valor ya parseado de un parámetro; los textos apuntan al path original
+using RouteParamValue = std::variant<int64_t, uint64_t, double, std::string_view>;
+
+// Parser de un tipo de parámetro: valida y convierte sin excepciones ni reservas
+using RouteParamParser = bool (*)(std::string_view, RouteParamValue &);
+
+namespace route_params
+{
+    inline bool parse_int(std::string_view value, RouteParamValue &out)
     {
-        static AnonymousRouteRegistry registry;
-        return registry;
+        // from_chars no acepta '+' explícito
+        if (!value.empty() && value[0] == '+')
+        {
+            value.remove_prefix(1);
+            if (value.empty() || value[0] == '-')
+            {
+                return false;
+            }
+        }
+
+        int64_t parsed;
+        auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+        if (value.empty() || ec != std::errc() || ptr != value.data() + value.size())
+        {
+            return false;
+        }
+        out = parsed;
+        return true;
     }
-    static bool match_route_pattern(const std::string &pattern, const std::string &path)
+
+    inline bool parse_uint(std::string_view value, RouteParamValue &out)
     {
-        size_t pattern_pos = 0;
-        size_t path_pos = 0;
+        if (!value.empty() && value[0] == '+')
+        {
+            value.remove_prefix(1);
+        }
 
-        while (pattern_pos < pattern.length() && path_pos < path.length())
+        uint64_t parsed;
+        auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+        if (value.empty() || ec != std::errc() || ptr != value.data() + value.size())
         {
-            // Si encontramos un parámetro en el patrón
-            if (pattern[pattern_pos] == '<')
+            return false;
+        }
+        out = parsed;
+        return true;
+    }
+
+    inline bool parse_double(std::string_view value, RouteParamValue &out)
+    {
+        // Igual que en los enteros: strtod (y Crow) aceptan '+'
+        if (!value.empty() && value[0] == '+')
+        {
+            value.remove_prefix(1);
+            if (value.empty() || value[0] == '-')
             {
-                // Buscar el cierre del parámetro
-                size_t close_pos = pattern.find('>', pattern_pos);
-                if (close_pos == std::string::npos)
-                {
-                    return false; // Patrón malformado
-                }
+                return false;
+            }
+        }
 
-                // Extraer el tipo de parámetro (int, string, etc.)
-                std::string param_type = pattern.substr(pattern_pos + 1, close_pos - pattern_pos - 1);
+        double parsed;
+        auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+        if (value.empty() || ec != std::errc() || ptr != value.data() + value.size())
+        {
+            return false;
+        }
+        out = parsed;
+        return true;
+    }
 
-                // Avanzar en el patrón hasta después del '>'
-                pattern_pos = close_pos + 1;
+    // string y path aceptan cualquier valor no vacío (path incluye '/')
+    inline bool parse_string(std::string_view value, RouteParamValue &out)
+    {
+        if (value.empty())
+        {
+            return false;
+        }
+        out = value;
+        return true;
+    }
 
-                // Buscar el siguiente '/' en el path o el final
-                size_t next_slash = path.find('/', path_pos);
-                if (next_slash == std::string::npos)
-                {
-                    next_slash = path.length();
-                }
+    // Resuelto una vez al registrar el patrón
+    inline RouteParamParser parser_for(RouteParamKind kind)
+    {
+        switch (kind)
+        {
+        case RouteParamKind::Int:
+            return &parse_int;
+        case RouteParamKind::UInt:
+            return &parse_uint;
+        case RouteParamKind::Double:
+            return &parse_double;
+        default:
+            return &parse_string;
+        }
+    }
+}
+
+// Trie de segmentos compilado a partir de los patrones registrados.
+// Cada nodo tiene hijos literales (lookup por hash sobre string_view) y un
+// hijo por cada tipo de parámetro, de modo que el match recorre el path una
+// sola vez. Validar no reserva memoria; capturar solo usa el vector que
+// pasa quien llama.
+class RouteTrie
+{
+private:
+    struct SegmentHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view segment) const
+        {
+            return std::hash<std::string_view>{}(segment);
+        }
+    };
 
-                // Extraer el valor del parámetro
-                std::string param_value = path.substr(path_pos, next_slash - path_pos);
+    struct Node;
 
-                // Validar que el valor coincida con el tipo esperado
-                if (!validate_param_type(param_type, param_value))
-                {
-                    return false;
-                }
+    struct ParamChild
+    {
+        RouteParamParser parse = nullptr;
+        std::unique_ptr<Node> node;
+    };
 
-                // Avanzar en el path
-                path_pos = next_slash;
-            }
-            else
-            {
-                // Comparación carácter por carácter
-                if (pattern[pattern_pos] != path[path_pos])
-                {
-                    return false;
-                }
-                pattern_pos++;
-                path_pos++;
-            }
+    struct Node
+    {
+        bool terminal = false;
+        std::unordered_map<std::string, std::unique_ptr<Node>, SegmentHash, std::equal_to<>> literals;
+        std::array<ParamChild, static_cast<size_t>(RouteParamKind::Count)> params;
+    };
+
+    Node root_;
+
+    static std::optional<RouteParamKind> parse_param_kind(std::string_view segment)
+    {
+        if (segment.size() < 2 || segment.front() != '<' || segment.back() != '>')
+        {
+            return std::nullopt; // Segmento literal
         }
 
-        // Ambos deben haber llegado al final
-        return pattern_pos == pattern.length() && path_pos == path.length();
+        std::string_view type = segment.substr(1, segment.size() - 2);
+        if (type == "int")
+            return RouteParamKind::Int;
+        if (type == "uint")
+            return RouteParamKind::UInt;
+        if (type == "double" || type == "float")
+            return RouteParamKind::Double;
+        if (type == "path")
+            return RouteParamKind::Path;
+
+        // string y tipos desconocidos: cualquier segmento no vacío
+        return RouteParamKind::String;
     }
 
-    static bool validate_param_type(const std::string &type, const std::string &value)
+    // Extrae el siguiente segmento de 'path' a partir de 'pos' (sin el '/')
+    static std::string_view next_segment(std::string_view path, size_t pos)
     {
-        if (value.empty())
+        size_t slash = path.find('/', pos);
+        return path.substr(pos, (slash == std::string_view::npos ? path.size() : slash) - pos);
+    }
+
+    // 'params' (opcional) recibe los valores en orden; al retroceder de una
+    // rama que no encaja se deshacen sus capturas
+    static bool match_node(const Node &node, std::string_view path, size_t pos,
+                           std::vector<RouteParamValue> *params)
+    {
+        std::string_view segment = next_segment(path, pos);
+        size_t next = pos + segment.size();
+        bool last = next == path.size();
+
+        // 1. Literal exacto
+        auto it = node.literals.find(segment);
+        if (it != node.literals.end() && match_child(*it->second, path, next, last, params))
         {
-            return false;
+            return true;
         }
 
-        if (type == "int" || type == "uint")
+        // 2. Parámetros tipados (path consume el resto, incluidas las '/')
+        for (size_t k = 0; k < node.params.size(); ++k)
         {
-            // Validar que sea un número entero
-            if (type == "uint" && value[0] == '-')
+            const ParamChild &child = node.params[k];
+            if (!child.node)
             {
-                return false; // uint no puede ser negativo
+                continue;
             }
 
-            size_t start = (value[0] == '-' || value[0] == '+') ? 1 : 0;
-            for (size_t i = start; i < value.length(); ++i)
+            RouteParamValue value;
+            if (static_cast<RouteParamKind>(k) == RouteParamKind::Path)
             {
-                if (!std::isdigit(value[i]))
+                if (child.parse(path.substr(pos), value))
                 {
-                    return false;
+                    if (params)
+                    {
+                        params->push_back(value);
+                    }
+                    return true;
                 }
+                continue;
             }
-            return value.length() > start; // Debe tener al menos un dígito
-        }
-        else if (type == "double" || type == "float")
-        {
-            // Validar que sea un número decimal
-            try
+
+            if (!child.parse(segment, value))
+            {
+                continue;
+            }
+            if (params)
+            {
+                params->push_back(value);
+            }
+            if (match_child(*child.node, path, next, last, params))
             {
-                std::stod(value);
                 return true;
             }
-            catch (...)
+            if (params)
             {
-                return false;
+                params->pop_back();
             }
         }
-        else if (type == "string")
-        {
-            // string acepta cualquier cosa que no sea '/'
-            return value.find('/') == std::string::npos;
-        }
-        else if (type == "path")
+
+        return false;
+    }
+
+    static bool match_child(const Node &child, std::string_view path, size_t next, bool last,
+                            std::vector<RouteParamValue> *params)
+    {
+        return last ? child.terminal : match_node(child, path, next + 1, params);
+    }
+
+public:
+    // Compila un patrón en el trie (solo al arrancar, no en el hot path)
+    void insert(std::string_view pattern)
+    {
+        Node *node = &root_;
+        size_t pos = 0;
+
+        while (true)
         {
-            // path acepta todo, incluyendo '/'
-            return true;
+            std::string_view segment = next_segment(pattern, pos);
+            auto kind = parse_param_kind(segment);
+
+            std::unique_ptr<Node> *slot;
+            if (kind)
+            {
+                ParamChild &child = node->params[static_cast<size_t>(*kind)];
+                child.parse = route_params::parser_for(*kind);
+                slot = &child.node;
+            }
+            else
+            {
+                auto it = node->literals.find(segment);
+                if (it == node->literals.end())
+                {
+                    it = node->literals.emplace(std::string(segment), nullptr).first;
+                }
+                slot = &it->second;
+            }
+
+            if (!*slot)
+            {
+                *slot = std::make_unique<Node>();
+            }
+            node = slot->get();
+
+            pos += segment.size();
+            // <path> absorbe el resto de la ruta
+            if (pos >= pattern.size() || kind == RouteParamKind::Path)
+            {
+                break;
+            }
+            ++pos; // Saltar '/'
         }
 
-        // Tipo desconocido, aceptar por defecto
-        return true;
+        node->terminal = true;
     }
 
-public:
-    static void register_anonymous(const std::string &route)
+    // Solo valida, sin reservas de memoria
+    bool match(std::string_view path) const
     {
-        instance().anonymous_routes_.insert(route);
+        return match_node(root_, path, 0, nullptr);
     }
 
-    static bool is_anonymous(const std::string &request_path)
+    // Valida y deja en 'params' los valores ya parseados, en orden y sin
+    // límite de parámetros. Se vacía primero; reutilizar el vector evita
+    // reservas. Los textos apuntan a 'path'.
+    bool match(std::string_view path, std::vector<RouteParamValue> &params) const
     {
-        // Primero intenta match exacto (para rutas sin parámetros)
-        if (instance().anonymous_routes_.find(request_path) != instance().anonymous_routes_.end())
+        params.clear();
+        if (match_node(root_, path, 0, &params))
         {
             return true;
         }
+        params.clear();
+        return false;
+    }
+
+    void clear()
+    {
+        root_ = Node{};
+    }
+};
+
+class AnonymousRouteRegistry
+{
+private:
+    std::unordered_set<std::string> anonymous_routes_;
+    RouteTrie trie_;
 
-        // Si no hay match exacto, intenta pattern matching
-        for (const auto &pattern : instance().anonymous_routes_)
+    static AnonymousRouteRegistry &instance()
+    {
+        static AnonymousRouteRegistry registry;
+        return registry;
+    }
+
+public:
+    static void register_anonymous(const std::string &route)
+    {
+        if (instance().anonymous_routes_.insert(route).second)
         {
-            if (match_route_pattern(pattern, request_path))
-            {
-                return true;
-            }
+            instance().trie_.insert(route);
         }
+    }
 
-        return false;
+    // Sin reservas de memoria y O(longitud del path)
+    static bool is_anonymous(std::string_view request_path)
+    {
+        return instance().trie_.match(request_path);
+    }
+
+    // Como is_anonymous(), pero devuelve también los parámetros parseados
+    // para que no haya que volver a convertir los segmentos
+    static bool match(std::string_view request_path, std::vector<RouteParamValue> &params)
+    {
+        return instance().trie_.match(request_path, params);
     }
 
     static void clear()
     {
         instance().anonymous_routes_.clear();
+        instance().trie_.clear();
     }
 
     static std::unordered_set<std::string> get_all()
@@ -271,12 +477,14 @@ struct AuthenticationMiddleware
     {
         bool authenticated = false;
         std::string user_id;
+        // Parámetros ya parseados de la ruta anónima que encajó
+        std::vector<RouteParamValue> route_params;
     };
 
     void before_handle(crow::request &req, crow::response &res, context &ctx)
     {
         // Verificar si la ruta es anónima
-        if (AnonymousRouteRegistry::is_anonymous(req.url))
+        if (AnonymousRouteRegistry::match(req.url, ctx.route_params))
         {
             CROW_LOG_DEBUG << "Anonymous route accessed: " << req.url;
             ctx.authenticated = true; // Permitir acceso
@@ -0,0 +1,121 @@
+#ifndef FEED_CAMBIOS_HPP
+#define FEED_CAMBIOS_HPP
+
+#include "tareas_db.hpp"
+#include "sse/sse_dispatcher.hpp"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <queue>
+#include <vector>
+
+// Publica los cambios de TareasDB como eventos SSE "cambio" del tema
+// "tareas", con la versión como id SSE. registrar() se llama desde la
+// escritura, ya sin mutex, y solo encola el registro POD sin bloqueos. El
+// hilo despachador reordena por versión (escrituras en shards distintos
+// pueden encolarse en cualquier orden), formatea el JSON y publica cada
+// tramo de versiones consecutivas. Un hueco normalmente solo espera a que
+// el escritor que lo tiene termine de encolar su cambio; si ese cambio no
+// llega nunca (p. ej. registrar() lanzó bad_alloc tras asignar la versión),
+// pasado 'espera_hueco' o con demasiados cambios retenidos se salta: los
+// clientes reciben un evento "reset", como cuando su versión ya no está en
+// el registro, y el feed sigue en lugar de quedarse parado.
+class FeedCambios {
+public:
+    using clock = std::chrono::steady_clock;
+
+    // Cambios retenidos tras un hueco a partir de los cuales se salta sin
+    // esperar a que venza el plazo
+    static constexpr size_t max_pendientes = 65536;
+
+    // 'version_inicial' es la versión de la base de datos antes del primer
+    // cambio que se registre
+    FeedCambios(SSEManager& manager, uint64_t version_inicial,
+                std::chrono::milliseconds espera_hueco = std::chrono::seconds(1))
+        : manager_(manager), siguiente_(version_inicial + 1), espera_hueco_(espera_hueco),
+          despachador_([this](std::vector<CambioTarea>& lote) {
+              publicar(lote);
+          }) {}
+
+    FeedCambios(const FeedCambios&) = delete;
+    FeedCambios& operator=(const FeedCambios&) = delete;
+
+    void registrar(const CambioTarea& cambio) {
+        despachador_.post(cambio);
+    }
+
+    // Revisa los huecos aunque no haya escrituras nuevas (llamarlo de forma
+    // periódica, p. ej. desde MantenimientoSse). Encola un cambio vacío: su
+    // versión 0 ya está publicada y se descarta.
+    void revisar() {
+        despachador_.post(CambioTarea{});
+    }
+
+    // Publica lo pendiente y termina el hilo. Idempotente.
+    void detener() {
+        despachador_.stop();
+    }
+
+private:
+    struct MayorVersion {
+        bool operator()(const CambioTarea& a, const CambioTarea& b) const {
+            return a.version > b.version;
+        }
+    };
+
+    // Solo desde el hilo despachador
+    void publicar(const std::vector<CambioTarea>& lote) {
+        for (const auto& cambio : lote) {
+            pendientes_.push(cambio);
+        }
+
+        mensajes_.clear();
+        publicarConsecutivos();
+        if (pendientes_.empty()) {
+            hueco_desde_.reset();
+        } else {
+            clock::time_point ahora = clock::now();
+            if (!hueco_desde_) {
+                hueco_desde_ = ahora;
+            }
+            if (ahora - *hueco_desde_ >= espera_hueco_ || pendientes_.size() >= max_pendientes) {
+                // Lleva el id de la última versión perdida: quien reanude
+                // después recibe solo los cambios siguientes
+                uint64_t perdida = pendientes_.top().version - 1;
+                SseMessage reset{"tareas", "reset", {}, perdida};
+                JsonWriter(reset.data).raw("{\"version\":").number(perdida).raw('}');
+                mensajes_.push_back(std::move(reset));
+                siguiente_ = perdida + 1;
+                hueco_desde_.reset();
+                publicarConsecutivos();
+            }
+        }
+        if (!mensajes_.empty()) {
+            manager_.publish_batch(mensajes_);
+        }
+    }
+
+    void publicarConsecutivos() {
+        while (!pendientes_.empty() && pendientes_.top().version <= siguiente_) {
+            const CambioTarea& cambio = pendientes_.top();
+            if (cambio.version == siguiente_) {
+                SseMessage mensaje{"tareas", "cambio", {}, cambio.version};
+                cambio.appendJson(mensaje.data);
+                mensajes_.push_back(std::move(mensaje));
+                ++siguiente_;
+            }
+            pendientes_.pop(); // Las ya publicadas o saltadas se descartan
+        }
+    }
+
+    SSEManager& manager_;
+    uint64_t siguiente_;   // Próxima versión a publicar
+    std::chrono::milliseconds espera_hueco_;
+    std::optional<clock::time_point> hueco_desde_;   // Desde cuándo se espera al primer hueco
+    std::priority_queue<CambioTarea, std::vector<CambioTarea>, MayorVersion> pendientes_;
+    std::vector<SseMessage> mensajes_;
+    // El último: su hilo usa los miembros anteriores y se para antes de destruirlos
+    BatchDispatcher<CambioTarea> despachador_;
+};
+
+#endif // FEED_CAMBIOS_HPP
@@ -2,25 +2,95 @@
 #define FIELD_REGISTRY_HPP
 
 #include "field_validator.hpp"
+#include "json_reader.hpp"
+#include "json_writer.hpp"
+#include <algorithm>
 #include <map>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <typeindex>
 #include <vector>
 
+// Lee el valor JSON actual directamente en el Field<T> apuntado
+using FieldParseFunc = bool (*)(void* field_ptr, JsonReader& reader);
+
+// Escribe el valor del Field<T> apuntado al final de 'out'
+using FieldWriteFunc = void (*)(const void* field_ptr, std::string& out);
+
+// Valida 'count' Field<T> consecutivos separados 'stride' bytes (el primero
+// en 'first') y activa en 'failed' el bit de cada uno que incumple alguna regla
+using FieldBatchFunc = void (*)(const IFieldValidator& validator, const char* first, size_t stride,
+                                size_t count, uint64_t* failed);
+
 // Información de un campo registrado
 struct FieldInfo {
+    std::string name;                             // Nombre JSON del campo
     std::shared_ptr<IFieldValidator> validator;  // El validador
     size_t offset;                                // Offset del campo en la clase (mutable)
     std::type_index value_type;                   // Tipo del valor (std::string, int, etc.)
-    std::function<std::pair<bool, std::string>(void*)> validate_func;  // Función de validación
+    std::function<ValidationError(const void*)> validate_func;  // Función de validación
+    FieldParseFunc parse_func;                    // Parser JSON según el tipo (resuelto al registrar)
+    FieldWriteFunc write_func;                    // Writer JSON según el tipo (resuelto al registrar)
+    FieldBatchFunc batch_func;                    // Validación por lotes según el tipo (resuelta al registrar)
+    std::string json_key;                         // "nombre": ya escapado, listo para copiar
     
-    FieldInfo(std::shared_ptr<IFieldValidator> val, size_t off, std::type_index type)
-        : validator(val), offset(off), value_type(type), validate_func(nullptr) {}
+    FieldInfo(std::string field_name, std::shared_ptr<IFieldValidator> val, size_t off, std::type_index type)
+        : FieldInfo(std::move(field_name), val, off, type, nullptr) {}
         
-    FieldInfo(std::shared_ptr<IFieldValidator> val, size_t off, std::type_index type,
-              std::function<std::pair<bool, std::string>(void*)> validate_fn)
-        : validator(val), offset(off), value_type(type), validate_func(validate_fn) {}
+    FieldInfo(std::string field_name, std::shared_ptr<IFieldValidator> val, size_t off, std::type_index type,
+              std::function<ValidationError(const void*)> validate_fn,
+              FieldParseFunc parse_fn = nullptr, FieldWriteFunc write_fn = nullptr,
+              FieldBatchFunc batch_fn = nullptr)
+        : name(std::move(field_name)), validator(val), offset(off), value_type(type),
+          validate_func(validate_fn), parse_func(parse_fn), write_func(write_fn), batch_func(batch_fn) {
+        JsonWriter(json_key).string(name).raw(':');
+    }
+};
+
+// Esquema inmutable de un modelo: sus campos en un array contiguo y un
+// índice de nombres ordenado para búsqueda binaria. Se construye una vez por
+// modelo a partir del registro y se accede mediante un puntero estático,
+// sin pasar por los mapas globales.
+class ModelSchema {
+public:
+    explicit ModelSchema(std::vector<FieldInfo> fields) : fields_(std::move(fields)) {
+        by_name_.reserve(fields_.size());
+        for (size_t i = 0; i < fields_.size(); ++i) {
+            by_name_.emplace_back(fields_[i].name, i);
+        }
+        std::sort(by_name_.begin(), by_name_.end());
+    }
+
+    // Los string_view de by_name_ apuntan a fields_: no se puede copiar
+    ModelSchema(const ModelSchema&) = delete;
+    ModelSchema& operator=(const ModelSchema&) = delete;
+
+    const std::vector<FieldInfo>& fields() const {
+        return fields_;
+    }
+
+    size_t size() const {
+        return fields_.size();
+    }
+
+    // Índice del campo con ese nombre JSON, o size() si no existe
+    size_t index_of(std::string_view name) const {
+        auto it = std::lower_bound(by_name_.begin(), by_name_.end(), name,
+                                   [](const auto& entry, std::string_view key) { return entry.first < key; });
+        return (it != by_name_.end() && it->first == name) ? it->second : fields_.size();
+    }
+
+    const FieldInfo* find(std::string_view name) const {
+        size_t index = index_of(name);
+        return index < fields_.size() ? &fields_[index] : nullptr;
+    }
+
+private:
+    std::vector<FieldInfo> fields_;
+    std::vector<std::pair<std::string_view, size_t>> by_name_;
 };
 
 // Singleton: Registro global de campos por tipo de modelo
@@ -38,20 +108,28 @@ public:
                        std::shared_ptr<IFieldValidator> validator,
                        size_t offset,
                        std::type_index value_type,
-                       std::function<std::pair<bool, std::string>(void*)> validate_func = nullptr) {
-        fields_[model_type].emplace_back(validator, offset, value_type, validate_func);
+                       std::function<ValidationError(const void*)> validate_func = nullptr,
+                       FieldParseFunc parse_func = nullptr,
+                       FieldWriteFunc write_func = nullptr,
+                       FieldBatchFunc batch_func = nullptr) {
+        std::unique_lock lock(mtx_);
+        fields_[model_type].emplace_back(field_name, validator, offset, value_type, validate_func,
+                                         parse_func, write_func, batch_func);
         field_names_[model_type][field_name] = fields_[model_type].size() - 1;
     }
 
-    // Obtener todos los campos de un tipo de modelo
+    // Obtener todos los campos de un tipo de modelo. Los campos de un modelo
+    // no cambian una vez registrado, así que la referencia sigue siendo válida.
     const std::vector<FieldInfo>& get_fields(std::type_index model_type) const {
         static std::vector<FieldInfo> empty;
+        std::shared_lock lock(mtx_);
         auto it = fields_.find(model_type);
         return it != fields_.end() ? it->second : empty;
     }
 
     // Obtener un campo específico por nombre
     const FieldInfo* get_field(std::type_index model_type, const std::string& field_name) const {
+        std::shared_lock lock(mtx_);
         auto model_it = field_names_.find(model_type);
         if (model_it == field_names_.end()) {
             return nullptr;
@@ -68,17 +146,20 @@ public:
 
     // Verificar si un modelo tiene campos registrados
     bool has_fields(std::type_index model_type) const {
+        std::shared_lock lock(mtx_);
         return fields_.find(model_type) != fields_.end();
     }
 
     // Obtener cantidad de campos registrados para un modelo
     size_t field_count(std::type_index model_type) const {
+        std::shared_lock lock(mtx_);
         auto it = fields_.find(model_type);
         return it != fields_.end() ? it->second.size() : 0;
     }
 
     // Actualizar el offset de un campo específico
     void update_field_offset(std::type_index model_type, const std::string& field_name, size_t new_offset) {
+        std::unique_lock lock(mtx_);
         auto model_it = field_names_.find(model_type);
         if (model_it == field_names_.end()) {
             return;
@@ -95,12 +176,14 @@ public:
 
     // Limpiar todos los registros (útil para testing)
     void clear() {
+        std::unique_lock lock(mtx_);
         fields_.clear();
         field_names_.clear();
     }
 
     // Limpiar registros de un modelo específico
     void clear_model(std::type_index model_type) {
+        std::unique_lock lock(mtx_);
         fields_.erase(model_type);
         field_names_.erase(model_type);
     }
@@ -113,6 +196,10 @@ private:
     FieldRegistry(const FieldRegistry&) = delete;
     FieldRegistry& operator=(const FieldRegistry&) = delete;
 
+    // Protege los mapas: el registro de modelos distintos puede ocurrir a la
+    // vez desde varios hilos. El hot path de los modelos usa ModelSchema.
+    mutable std::shared_mutex mtx_;
+
     // Almacenamiento: type_index -> vector de FieldInfo
     std::map<std::type_index, std::vector<FieldInfo>> fields_;
 
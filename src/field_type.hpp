@@ -3,10 +3,13 @@
 
 #include "field_validator.hpp"
 #include "field_registry.hpp"
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <typeindex>
 #include <iostream>
+#include <vector>
 
 // Contexto para el registro
 struct FieldRegistrationContext {
@@ -20,29 +23,66 @@ struct FieldRegistrationContext {
 
 inline thread_local FieldRegistrationContext* current_context = nullptr;
 
-// Field<T> como tipo que envuelve un valor
+// Flag para evitar recursión durante el registro
+inline thread_local bool in_registration = false;
+
+// Metadatos que deja un Field<T> al construirse dentro de la instancia
+// temporal de registro. BaseModel los recoge por dirección y los mueve al
+// esquema del modelo; las instancias normales no guardan nada de esto.
+struct PendingField {
+    const void* address;
+    std::string name;
+    std::shared_ptr<IFieldValidator> validator;
+};
+
+inline thread_local std::vector<PendingField> pending_fields;
+
+// Field<T> como tipo que envuelve un valor. Solo contiene el valor: el
+// nombre JSON, las opciones y el validador viven una única vez en el
+// esquema del modelo.
 template<typename T>
 class Field {
 public:
     // Constructor con nombre del campo JSON y opciones
-    Field(const std::string& json_field_name, typename FieldValidator<T>::Options options)
-        : json_field_name_(json_field_name), value_() {
-        
-        // Crear validador
-        validator_ = std::make_shared<FieldValidator<T>>(json_field_name, options);
+    Field(std::string_view json_field_name, typename FieldValidator<T>::Options options)
+        : value_() {
         
         // Si hay valor por defecto, asignarlo
         if (options.default_val) {
             value_ = *options.default_val;
         }
         
-        // NO registramos aquí - BaseModel lo hará después
+        // Solo durante el registro se crea el validador (una vez por modelo)
+        if (in_registration) {
+            std::string name(json_field_name);
+            auto validator = std::make_shared<FieldValidator<T>>(name, std::move(options));
+            pending_fields.push_back({this, std::move(name), std::move(validator)});
+        }
     }
     
     // Constructor básico: solo required
-    Field(const std::string& json_field_name, bool required = false)
+    Field(std::string_view json_field_name, bool required = false)
         : Field(json_field_name, create_basic_options(required)) {}
     
+    // Si el Field se copia o mueve durante el registro, sus metadatos le siguen
+    Field(const Field& other) : value_(other.value_) {
+        relocate_pending(&other);
+    }
+    
+    Field(Field&& other) noexcept : value_(std::move(other.value_)) {
+        relocate_pending(&other);
+    }
+    
+    Field& operator=(const Field& other) {
+        value_ = other.value_;
+        return *this;
+    }
+    
+    Field& operator=(Field&& other) noexcept {
+        value_ = std::move(other.value_);
+        return *this;
+    }
+    
     // Destructor
     ~Field() = default;
     
@@ -71,42 +111,84 @@ public:
         return value_;
     }
     
-    // Validar este campo
-    std::pair<bool, std::string> validate() const {
-        return validator_->validate(value_);
-    }
-    
-    // Obtener validador
-    std::shared_ptr<FieldValidator<T>> get_validator() const {
-        return validator_;
-    }
-    
-    // Obtener nombre del campo
-    std::string get_field_name() const {
-        return json_field_name_;
-    }
-    
-    // Registrar este campo en el registry (llamado por BaseModel)
-    void register_in_registry(std::type_index model_type, size_t offset) {
-        auto validate_fn = [](void* field_ptr) -> std::pair<bool, std::string> {
-            Field<T>* field = static_cast<Field<T>*>(field_ptr);
-            return field->validate();
+    // Registrar este campo en el registry (llamado por BaseModel sobre la
+    // instancia temporal)
+    void register_in_registry(std::type_index model_type, size_t offset) const {
+        auto it = std::find_if(pending_fields.begin(), pending_fields.end(),
+                               [this](const PendingField& pending) { return pending.address == this; });
+        if (it == pending_fields.end()) {
+            return;
+        }
+        
+        auto validator = std::static_pointer_cast<FieldValidator<T>>(it->validator);
+        auto validate_fn = [validator](const void* field_ptr) -> ValidationError {
+            return validator->check(static_cast<const Field<T>*>(field_ptr)->value_);
         };
         
         FieldRegistry::instance().register_field(
             model_type,
-            json_field_name_,
-            validator_,
+            it->name,
+            it->validator,
             offset,
             std::type_index(typeid(T)),
-            validate_fn
+            validate_fn,
+            &Field<T>::parse_json,
+            &Field<T>::write_json,
+            &Field<T>::check_batch
         );
+        pending_fields.erase(it);
+    }
+
+    // Escribe value_ como JSON al final de 'out'
+    static void write_json(const void* field_ptr, std::string& out) {
+        const T& value = static_cast<const Field<T>*>(field_ptr)->value_;
+        JsonWriter json(out);
+        if constexpr (std::is_same_v<T, std::string>) {
+            json.string(value);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            json.boolean(value);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            json.number(value);
+        } else {
+            (void)value;
+            json.null(); // Tipo sin representación JSON
+        }
+    }
+
+    // Valida un lote de Field<T> del mismo modelo (ver FieldBatchFunc)
+    static void check_batch(const IFieldValidator& validator, const char* first, size_t stride,
+                            size_t count, uint64_t* failed) {
+        auto value_at = [first, stride](size_t i) -> const T& {
+            return reinterpret_cast<const Field<T>*>(first + i * stride)->value_;
+        };
+        static_cast<const FieldValidator<T>&>(validator).check_batch(value_at, count, failed);
+    }
+
+    // Lee el valor JSON en curso directamente sobre value_
+    static bool parse_json(void* field_ptr, JsonReader& reader) {
+        Field<T>* field = static_cast<Field<T>*>(field_ptr);
+        if constexpr (std::is_same_v<T, std::string> || std::is_arithmetic_v<T>) {
+            return reader.read(field->value_);
+        } else {
+            (void)field;
+            (void)reader;
+            return false; // Tipo sin lectura JSON
+        }
     }
 
 private:
-    std::string json_field_name_;
     T value_;
-    std::shared_ptr<FieldValidator<T>> validator_;
+    
+    void relocate_pending(const Field* from) {
+        if (!in_registration) {
+            return;
+        }
+        for (auto& pending : pending_fields) {
+            if (pending.address == from) {
+                pending.address = this;
+            }
+        }
+    }
     
     // Helper para crear opciones básicas
     static typename FieldValidator<T>::Options create_basic_options(bool required) {
@@ -128,44 +210,41 @@ std::ostream& operator<<(std::ostream& os, const Field<T>& field) {
 // String con longitudes
 template<typename T>
 typename std::enable_if<std::is_same<T, std::string>::value, Field<T>>::type
-CreateField(const std::string& json_name, bool required, size_t min_len, size_t max_len) {
+CreateField(std::string_view json_name, bool required, size_t min_len, size_t max_len) {
     typename FieldValidator<T>::Options opts;
     opts.required = required;
     opts.min_length = min_len;
     opts.max_length = max_len;
-    return Field<T>(json_name, opts);
+    return Field<T>(json_name, std::move(opts));
 }
 
 // Número con rango
 template<typename T>
 typename std::enable_if<std::is_arithmetic<T>::value, Field<T>>::type
-CreateField(const std::string& json_name, bool required, T min_val, T max_val) {
+CreateField(std::string_view json_name, bool required, T min_val, T max_val) {
     typename FieldValidator<T>::Options opts;
     opts.required = required;
     opts.min_value = min_val;
     opts.max_value = max_val;
-    return Field<T>(json_name, opts);
+    return Field<T>(json_name, std::move(opts));
 }
 
 // Con valor por defecto
 template<typename T>
-Field<T> CreateField(const std::string& json_name, T default_value) {
+Field<T> CreateField(std::string_view json_name, T default_value) {
     typename FieldValidator<T>::Options opts;
     opts.required = false;
-    opts.default_val = default_value;
-    
-    Field<T> field(json_name, opts);
-    field = default_value;  // Asignar el valor por defecto
-    return field;
+    opts.default_val = default_value;  // El constructor lo asigna
+    return Field<T>(json_name, std::move(opts));
 }
 
 // Con valores permitidos (enum)
 template<typename T>
-Field<T> CreateField(const std::string& json_name, bool required, const std::vector<T>& allowed) {
+Field<T> CreateField(std::string_view json_name, bool required, const std::vector<T>& allowed) {
     typename FieldValidator<T>::Options opts;
     opts.required = required;
     opts.allowed_values = allowed;
-    return Field<T>(json_name, opts);
+    return Field<T>(json_name, std::move(opts));
 }
 
 #endif // FIELD_TYPE_HPP
\ No newline at end of file
@@ -1,13 +1,48 @@
 #ifndef FIELD_VALIDATOR_HPP
 #define FIELD_VALIDATOR_HPP
 
+#include "pattern_cache.hpp"
+#include "validation_simd.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <regex>
 #include <sstream>
+#include <stdexcept>
 #include <type_traits>
+#include <unordered_set>
+#include <variant>
+
+// Regla de validación incumplida
+enum class ValidationRule : uint8_t
+{
+    None = 0,
+    MinLength,
+    MaxLength,
+    Pattern,
+    MinValue,
+    MaxValue,
+    AllowedValues,
+    Custom
+};
+
+// Error de validación compacto: no contiene strings. El mensaje legible se
+// genera solo cuando alguien lo pide (IFieldValidator::format_error).
+struct ValidationError
+{
+    uint32_t field_index = 0;                   // Índice del campo en el modelo
+    ValidationRule rule = ValidationRule::None; // Regla incumplida
+    double bound = 0;                           // Límite de la regla (longitud o valor), si aplica
+
+    explicit operator bool() const
+    {
+        return rule != ValidationRule::None;
+    }
+};
 
 class IFieldValidator
 {
@@ -20,6 +55,12 @@ public:
     // Obtener descripción
     virtual std::string get_description() const = 0;
 
+    // Indica si el campo es obligatorio
+    virtual bool is_required() const = 0;
+
+    // Construye el mensaje legible de un error de este campo
+    virtual std::string format_error(const ValidationError &error) const = 0;
+
 protected:
     IFieldValidator() = default;
 };
@@ -47,26 +88,167 @@ class FieldValidator : public IFieldValidator
 public:
     using Options = FieldOptions<T>;
 
+    // El patrón regex se compila aquí (o se toma de la caché); un patrón
+    // inválido se rechaza al construir, no en cada validación.
     FieldValidator(const std::string &field_name, Options opts)
-        : field_name_(field_name), options_(opts) {}
+        : field_name_(field_name), options_(opts)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            if (options_.pattern)
+            {
+                try
+                {
+                    pattern_ = PatternCache::get(*options_.pattern);
+                }
+                catch (const std::regex_error &)
+                {
+                    throw std::invalid_argument("Field '" + field_name_ + "' has invalid regex pattern: " +
+                                                *options_.pattern);
+                }
+            }
+        }
 
-    // Validar un valor según las reglas
-    std::pair<bool, std::string> validate(const T &value) const
+        // Las whitelists grandes se consultan con un hash set construido una vez
+        if constexpr (hashable)
+        {
+            if (options_.allowed_values.size() > small_whitelist)
+            {
+                allowed_set_.insert(options_.allowed_values.begin(), options_.allowed_values.end());
+            }
+        }
+    }
+
+    // Comprobar un valor según las reglas. No reserva memoria: devuelve un
+    // error vacío si todo es correcto (field_index lo rellena el modelo).
+    ValidationError check(const T &value) const
     {
         // Validaciones específicas por tipo usando if constexpr (C++17)
         if constexpr (std::is_same_v<T, std::string>)
         {
-            return validate_string(value);
+            return check_string(value);
         }
         else if constexpr (std::is_arithmetic_v<T>)
         {
-            return validate_numeric(value);
+            return check_numeric(value);
         }
         else
         {
             // Para otros tipos, solo validación custom
-            return validate_custom(value);
+            return check_custom(value);
+        }
+    }
+
+    // Validación por lotes: 'value_at(i)' devuelve el valor del objeto i y
+    // 'failed' es un bitmap (un bit por objeto) donde se marcan los que
+    // incumplen alguna regla. Rangos y longitudes se comprueban en bucles
+    // sin saltos que el compilador puede vectorizar; patrón, whitelist y
+    // custom solo se evalúan sobre los objetos que aún no han fallado.
+    template <typename ValueAt>
+    void check_batch(ValueAt &&value_at, size_t count, uint64_t *failed) const
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            if (options_.min_length || options_.max_length)
+            {
+                mark_out_of_range(
+                    [&value_at](size_t i) { return value_at(i).length(); }, count,
+                    options_.min_length, options_.max_length, failed);
+            }
+        }
+        else if constexpr (std::is_arithmetic_v<T>)
+        {
+            if (options_.min_value || options_.max_value)
+            {
+                mark_out_of_range(value_at, count, options_.min_value, options_.max_value, failed);
+            }
+        }
+
+        // Whitelist pequeña de int/double: compare-any vectorial por bloques
+        bool whitelist_done = false;
+        if constexpr (validation_simd::vectorized<T>)
+        {
+            if (!options_.allowed_values.empty() && !uses_allowed_set())
+            {
+                mark_not_allowed(value_at, count, failed);
+                whitelist_done = true;
+            }
+        }
+
+        bool has_pattern = false;
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            has_pattern = pattern_ != nullptr;
+        }
+        bool whitelist_pending = !options_.allowed_values.empty() && !whitelist_done;
+        if (!has_pattern && !whitelist_pending && !options_.custom_validator)
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint64_t bit = uint64_t{1} << (i % 64);
+            if ((failed[i / 64] & bit) == 0 && check(value_at(i)))
+            {
+                failed[i / 64] |= bit;
+            }
+        }
+    }
+
+    // Validar un valor y obtener directamente el mensaje de error
+    std::pair<bool, std::string> validate(const T &value) const
+    {
+        ValidationError error = check(value);
+        if (!error)
+        {
+            return {true, ""};
+        }
+        return {false, format_error(error)};
+    }
+
+    std::string format_error(const ValidationError &error) const
+    {
+        std::ostringstream oss;
+        oss << "Field '" << field_name_ << "' ";
+
+        switch (error.rule)
+        {
+        case ValidationRule::None:
+            return "";
+        case ValidationRule::MinLength:
+            oss << "must have at least " << *options_.min_length << " characters";
+            break;
+        case ValidationRule::MaxLength:
+            oss << "must have at most " << *options_.max_length << " characters";
+            break;
+        case ValidationRule::Pattern:
+            oss << "does not match required pattern";
+            break;
+        case ValidationRule::MinValue:
+            if constexpr (std::is_arithmetic_v<T>)
+            {
+                oss << "must be at least " << *options_.min_value;
+            }
+            break;
+        case ValidationRule::MaxValue:
+            if constexpr (std::is_arithmetic_v<T>)
+            {
+                oss << "must be at most " << *options_.max_value;
+            }
+            break;
+        case ValidationRule::AllowedValues:
+            oss << "must be one of the allowed values";
+            break;
+        case ValidationRule::Custom:
+            if (!options_.custom_error_msg.empty())
+            {
+                return options_.custom_error_msg;
+            }
+            oss << "failed custom validation";
+            break;
         }
+        return oss.str();
     }
 
     // Validar si el campo es requerido
@@ -94,108 +276,161 @@ public:
     }
 
 private:
+    static ValidationError fail(ValidationRule rule, double bound = 0)
+    {
+        return {0, rule, bound};
+    }
+
+    // Tamaño hasta el que la whitelist se recorre entera (SIMD en lotes)
+    // en lugar de usar el hash set
+    static constexpr size_t small_whitelist = 16;
+
+    static constexpr bool hashable = std::is_arithmetic_v<T> || std::is_same_v<T, std::string>;
+
+    bool uses_allowed_set() const
+    {
+        if constexpr (hashable)
+        {
+            return !allowed_set_.empty();
+        }
+        return false;
+    }
+
+    // Marca los valores fuera de [min, max]: se copian de 64 en 64 a un
+    // bloque contiguo y se comprueban con el kernel de validation_simd
+    template <typename ValueAt, typename Bound>
+    static void mark_out_of_range(ValueAt &&value_at, size_t count, const std::optional<Bound> &min,
+                                  const std::optional<Bound> &max, uint64_t *failed)
+    {
+        const Bound lo = min.value_or(Bound{});
+        const Bound hi = max.value_or(Bound{});
+        Bound block[validation_simd::block_size];
+
+        for (size_t base = 0; base < count; base += validation_simd::block_size)
+        {
+            size_t n = std::min(validation_simd::block_size, count - base);
+            for (size_t j = 0; j < n; ++j)
+            {
+                block[j] = value_at(base + j);
+            }
+            failed[base / 64] |= validation_simd::out_of_range(block, n, min.has_value(), lo, max.has_value(), hi);
+        }
+    }
+
+    // Marca los valores que no están en la whitelist (pequeña)
+    template <typename ValueAt>
+    void mark_not_allowed(ValueAt &&value_at, size_t count, uint64_t *failed) const
+    {
+        const auto &allowed = options_.allowed_values;
+        T block[validation_simd::block_size];
+
+        for (size_t base = 0; base < count; base += validation_simd::block_size)
+        {
+            size_t n = std::min(validation_simd::block_size, count - base);
+            for (size_t j = 0; j < n; ++j)
+            {
+                block[j] = value_at(base + j);
+            }
+            failed[base / 64] |= validation_simd::not_in(block, n, allowed.data(), allowed.size());
+        }
+    }
+
     // Validaciones específicas para strings
-    std::pair<bool, std::string> validate_string(const std::string &value) const
+    ValidationError check_string(const std::string &value) const
     {
         // Longitud mínima
         if (options_.min_length && value.length() < *options_.min_length)
         {
-            return {false, "Field '" + field_name_ + "' must have at least " +
-                               std::to_string(*options_.min_length) + " characters"};
+            return fail(ValidationRule::MinLength, static_cast<double>(*options_.min_length));
         }
 
         // Longitud máxima
         if (options_.max_length && value.length() > *options_.max_length)
         {
-            return {false, "Field '" + field_name_ + "' must have at most " +
-                               std::to_string(*options_.max_length) + " characters"};
+            return fail(ValidationRule::MaxLength, static_cast<double>(*options_.max_length));
         }
 
-        // Patrón regex
-        if (options_.pattern)
+        // Patrón regex (precompilado)
+        if (pattern_ && !pattern_->matches(value))
         {
-            try
-            {
-                std::regex regex_pattern(*options_.pattern);
-                if (!std::regex_match(value, regex_pattern))
-                {
-                    return {false, "Field '" + field_name_ + "' does not match required pattern"};
-                }
-            }
-            catch (const std::regex_error &e)
-            {
-                return {false, "Field '" + field_name_ + "' has invalid regex pattern"};
-            }
+            return fail(ValidationRule::Pattern);
         }
 
         // Valores permitidos y custom
-        return validate_allowed_and_custom(value);
+        return check_allowed_and_custom(value);
     }
 
     // Validaciones específicas para números
-    std::pair<bool, std::string> validate_numeric(const T &value) const
+    ValidationError check_numeric(const T &value) const
     {
         // Valor mínimo
         if (options_.min_value && value < *options_.min_value)
         {
-            std::ostringstream oss;
-            oss << "Field '" << field_name_ << "' must be at least " << *options_.min_value;
-            return {false, oss.str()};
+            return fail(ValidationRule::MinValue, static_cast<double>(*options_.min_value));
         }
 
         // Valor máximo
         if (options_.max_value && value > *options_.max_value)
         {
-            std::ostringstream oss;
-            oss << "Field '" << field_name_ << "' must be at most " << *options_.max_value;
-            return {false, oss.str()};
+            return fail(ValidationRule::MaxValue, static_cast<double>(*options_.max_value));
         }
 
         // Valores permitidos y custom
-        return validate_allowed_and_custom(value);
+        return check_allowed_and_custom(value);
     }
 
     // Validar valores permitidos (enum/whitelist)
-    std::pair<bool, std::string> validate_allowed_and_custom(const T &value) const
+    ValidationError check_allowed_and_custom(const T &value) const
     {
         // Valores permitidos
         if (!options_.allowed_values.empty())
         {
-            bool found = false;
-            for (const auto &allowed : options_.allowed_values)
+            bool found;
+            if constexpr (hashable)
             {
-                if (value == allowed)
-                {
-                    found = true;
-                    break;
-                }
+                found = uses_allowed_set() ? allowed_set_.count(value) != 0 : is_in_list(value);
+            }
+            else
+            {
+                found = is_in_list(value);
             }
             if (!found)
             {
-                return {false, "Field '" + field_name_ + "' must be one of the allowed values"};
+                return fail(ValidationRule::AllowedValues);
             }
         }
 
         // Validador custom
-        return validate_custom(value);
+        return check_custom(value);
+    }
+
+    bool is_in_list(const T &value) const
+    {
+        for (const auto &allowed : options_.allowed_values)
+        {
+            if (value == allowed)
+            {
+                return true;
+            }
+        }
+        return false;
     }
 
     // Validador personalizado
-    std::pair<bool, std::string> validate_custom(const T &value) const
+    ValidationError check_custom(const T &value) const
     {
         if (options_.custom_validator && !options_.custom_validator(value))
         {
-            std::string error_msg = options_.custom_error_msg.empty()
-                                        ? "Field '" + field_name_ + "' failed custom validation"
-                                        : options_.custom_error_msg;
-            return {false, error_msg};
+            return fail(ValidationRule::Custom);
         }
 
-        return {true, ""}; // Todo OK
+        return {}; // Todo OK
     }
 
     std::string field_name_;
     Options options_;
+    std::shared_ptr<const CompiledPattern> pattern_;
+    std::conditional_t<hashable, std::unordered_set<T>, std::monostate> allowed_set_;
 };
 
 #endif // FIELD_VALIDATOR_HPP
\ No newline at end of file
@@ -0,0 +1,329 @@
+#ifndef JSON_READER_HPP
+#define JSON_READER_HPP
+
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Lector JSON de tipo "pull" sobre un string_view: no construye ningún DOM.
+// Quien lo usa recorre los miembros del objeto raíz y lee cada valor
+// directamente en su destino final; los valores que no interesan se saltan.
+// Ningún método lanza excepciones: devuelven false ante un error.
+class JsonReader {
+public:
+    static constexpr int max_depth = 64;
+
+    explicit JsonReader(std::string_view input) : in_(input) {}
+
+    // Consume el '{' del objeto raíz
+    bool begin_object() {
+        skip_ws();
+        first_member_ = true;
+        return consume('{');
+    }
+
+    // Avanza al siguiente miembro del objeto raíz y deja su clave en 'key'
+    // (sin escapar). Devuelve false al llegar a '}' o si hay un error;
+    // failed() distingue ambos casos.
+    bool next_member(std::string_view& key) {
+        skip_ws();
+        if (peek() == '}') {
+            ++pos_;
+            return false;
+        }
+        if (!first_member_ && !consume(',')) {
+            return fail();
+        }
+        first_member_ = false;
+
+        skip_ws();
+        if (!scan_string(key)) {
+            return fail();
+        }
+        skip_ws();
+        if (!consume(':')) {
+            return fail();
+        }
+        skip_ws();
+        return true;
+    }
+
+    // Tras el objeto raíz solo puede haber espacios
+    bool at_end() {
+        skip_ws();
+        return !error_ && pos_ == in_.size();
+    }
+
+    bool failed() const {
+        return error_;
+    }
+
+    // Consume un 'null' si es el siguiente valor
+    bool read_null() {
+        if (in_.substr(pos_, 4) == "null") {
+            pos_ += 4;
+            return true;
+        }
+        return false;
+    }
+
+    // String: se desescapa directamente en 'out' (una sola copia)
+    bool read(std::string& out) {
+        std::string_view raw;
+        if (!scan_string(raw)) {
+            return fail();
+        }
+        out.clear();
+        return unescape(raw, out) || fail();
+    }
+
+    bool read(bool& out) {
+        if (in_.substr(pos_, 4) == "true") {
+            pos_ += 4;
+            out = true;
+            return true;
+        }
+        if (in_.substr(pos_, 5) == "false") {
+            pos_ += 5;
+            out = false;
+            return true;
+        }
+        return fail();
+    }
+
+    // Números con std::from_chars; un entero no admite parte decimal
+    template<typename T>
+    std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, bool>
+    read(T& out) {
+        std::string_view number;
+        if (!scan_number(number)) {
+            return fail();
+        }
+        auto [ptr, ec] = std::from_chars(number.data(), number.data() + number.size(), out);
+        return (ec == std::errc() && ptr == number.data() + number.size()) || fail();
+    }
+
+    // Salta un valor completo de cualquier tipo
+    bool skip_value() {
+        return skip_value(0) || fail();
+    }
+
+private:
+    std::string_view in_;
+    size_t pos_ = 0;
+    bool first_member_ = true;
+    bool error_ = false;
+
+    bool fail() {
+        error_ = true;
+        return false;
+    }
+
+    char peek() const {
+        return pos_ < in_.size() ? in_[pos_] : '\0';
+    }
+
+    bool consume(char c) {
+        if (peek() != c) {
+            return false;
+        }
+        ++pos_;
+        return true;
+    }
+
+    void skip_ws() {
+        while (pos_ < in_.size() &&
+               (in_[pos_] == ' ' || in_[pos_] == '\t' || in_[pos_] == '\n' || in_[pos_] == '\r')) {
+            ++pos_;
+        }
+    }
+
+    // Delimita un string JSON y devuelve su contenido sin las comillas
+    bool scan_string(std::string_view& raw) {
+        if (!consume('"')) {
+            return false;
+        }
+        size_t start = pos_;
+        while (pos_ < in_.size()) {
+            char c = in_[pos_];
+            if (c == '"') {
+                raw = in_.substr(start, pos_ - start);
+                ++pos_;
+                return true;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) {
+                return false; // Control sin escapar
+            }
+            pos_ += (c == '\\') ? 2 : 1;
+        }
+        return false;
+    }
+
+    // Delimita un número JSON (-?int frac? exp?)
+    bool scan_number(std::string_view& number) {
+        size_t start = pos_;
+        consume('-');
+        if (!is_digit(peek())) {
+            return false;
+        }
+        if (!consume('0')) {
+            while (is_digit(peek())) ++pos_;
+        }
+        if (consume('.')) {
+            if (!is_digit(peek())) return false;
+            while (is_digit(peek())) ++pos_;
+        }
+        if (peek() == 'e' || peek() == 'E') {
+            ++pos_;
+            if (peek() == '+' || peek() == '-') ++pos_;
+            if (!is_digit(peek())) return false;
+            while (is_digit(peek())) ++pos_;
+        }
+        number = in_.substr(start, pos_ - start);
+        return true;
+    }
+
+    bool skip_value(int depth) {
+        if (depth > max_depth) {
+            return false;
+        }
+        skip_ws();
+        std::string_view ignored;
+        switch (peek()) {
+            case '"':
+                return scan_string(ignored);
+            case 't': {
+                bool b;
+                return read(b);
+            }
+            case 'f': {
+                bool b;
+                return read(b);
+            }
+            case 'n':
+                return read_null();
+            case '{':
+            case '[': {
+                char close = peek() == '{' ? '}' : ']';
+                ++pos_;
+                skip_ws();
+                if (consume(close)) {
+                    return true;
+                }
+                do {
+                    skip_ws();
+                    if (close == '}') {
+                        if (!scan_string(ignored)) return false;
+                        skip_ws();
+                        if (!consume(':')) return false;
+                    }
+                    if (!skip_value(depth + 1)) return false;
+                    skip_ws();
+                } while (consume(','));
+                return consume(close);
+            }
+            default:
+                return scan_number(ignored);
+        }
+    }
+
+    static bool is_digit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    static int hex_value(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    static bool read_hex4(std::string_view raw, size_t pos, uint32_t& code) {
+        if (pos + 4 > raw.size()) {
+            return false;
+        }
+        code = 0;
+        for (size_t i = pos; i < pos + 4; ++i) {
+            int v = hex_value(raw[i]);
+            if (v < 0) return false;
+            code = (code << 4) | static_cast<uint32_t>(v);
+        }
+        return true;
+    }
+
+    static void append_utf8(uint32_t code, std::string& out) {
+        if (code < 0x80) {
+            out.push_back(static_cast<char>(code));
+        } else if (code < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else if (code < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+    }
+
+    // Copia 'raw' a 'out' resolviendo las secuencias de escape
+    static bool unescape(std::string_view raw, std::string& out) {
+        size_t backslash = raw.find('\\');
+        if (backslash == std::string_view::npos) {
+            out.append(raw); // Caso habitual: copia directa
+            return true;
+        }
+
+        out.reserve(raw.size());
+        size_t run_start = 0;
+        for (size_t i = backslash; i < raw.size(); ++i) {
+            if (raw[i] != '\\') {
+                continue;
+            }
+            out.append(raw.data() + run_start, i - run_start);
+            if (++i >= raw.size()) {
+                return false;
+            }
+
+            switch (raw[i]) {
+                case '"':  out.push_back('"'); break;
+                case '\\': out.push_back('\\'); break;
+                case '/':  out.push_back('/'); break;
+                case 'b':  out.push_back('\b'); break;
+                case 'f':  out.push_back('\f'); break;
+                case 'n':  out.push_back('\n'); break;
+                case 'r':  out.push_back('\r'); break;
+                case 't':  out.push_back('\t'); break;
+                case 'u': {
+                    uint32_t code;
+                    if (!read_hex4(raw, i + 1, code)) return false;
+                    i += 4;
+                    // Pares sustitutos UTF-16
+                    if (code >= 0xD800 && code <= 0xDBFF) {
+                        uint32_t low;
+                        if (i + 2 >= raw.size() || raw[i + 1] != '\\' || raw[i + 2] != 'u' ||
+                            !read_hex4(raw, i + 3, low) || low < 0xDC00 || low > 0xDFFF) {
+                            return false;
+                        }
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                    append_utf8(code, out);
+                    break;
+                }
+                default:
+                    return false;
+            }
+            run_start = i + 1;
+        }
+        out.append(raw.data() + run_start, raw.size() - run_start);
+        return true;
+    }
+};
+
+#endif // JSON_READER_HPP
@@ -0,0 +1,105 @@
+#ifndef JSON_WRITER_HPP
+#define JSON_WRITER_HPP
+
+#include <charconv>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Escritor JSON mínimo que añade directamente al final de un buffer.
+// No construye ningún árbol intermedio: quien lo usa escribe las claves
+// (ya escapadas) con raw() y los valores con los métodos tipados.
+// El buffer puede ser std::string o std::pmr::string (p. ej. en la arena
+// de la petición).
+template<typename String>
+class BasicJsonWriter {
+public:
+    explicit BasicJsonWriter(String& out) : out_(out) {}
+
+    // Texto que ya es JSON válido (claves, separadores...)
+    BasicJsonWriter& raw(std::string_view text) {
+        out_.append(text);
+        return *this;
+    }
+
+    BasicJsonWriter& raw(char c) {
+        out_.push_back(c);
+        return *this;
+    }
+
+    // String entre comillas, escapado en una sola pasada
+    BasicJsonWriter& string(std::string_view value) {
+        out_.push_back('"');
+        escape(value, out_);
+        out_.push_back('"');
+        return *this;
+    }
+
+    BasicJsonWriter& boolean(bool value) {
+        out_.append(value ? "true" : "false");
+        return *this;
+    }
+
+    // Enteros y coma flotante con std::to_chars (sin ostringstream ni locale)
+    template<typename T>
+    std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, BasicJsonWriter&>
+    number(T value) {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (!std::isfinite(value)) {
+                out_.append("null"); // JSON no admite NaN ni infinito
+                return *this;
+            }
+        }
+
+        char buffer[32];
+        auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        (void)ec; // 32 bytes bastan para cualquier tipo aritmético
+        out_.append(buffer, ptr);
+        return *this;
+    }
+
+    BasicJsonWriter& null() {
+        out_.append("null");
+        return *this;
+    }
+
+    // Escapa 'value' al final de 'out'. Los tramos sin caracteres especiales
+    // se copian de una vez.
+    static void escape(std::string_view value, String& out) {
+        static constexpr char hex[] = "0123456789abcdef";
+
+        size_t run_start = 0;
+        for (size_t i = 0; i < value.size(); ++i) {
+            unsigned char c = static_cast<unsigned char>(value[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+
+            out.append(value.data() + run_start, i - run_start);
+            run_start = i + 1;
+
+            switch (c) {
+                case '"':  out.append("\\\""); break;
+                case '\\': out.append("\\\\"); break;
+                case '\n': out.append("\\n"); break;
+                case '\r': out.append("\\r"); break;
+                case '\t': out.append("\\t"); break;
+                case '\b': out.append("\\b"); break;
+                case '\f': out.append("\\f"); break;
+                default: {
+                    char unicode[] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                    out.append(unicode, sizeof(unicode));
+                }
+            }
+        }
+        out.append(value.data() + run_start, value.size() - run_start);
+    }
+
+private:
+    String& out_;
+};
+
+using JsonWriter = BasicJsonWriter<std::string>;
+
+#endif // JSON_WRITER_HPP
@@ -1,91 +1,119 @@
 #include "crow.h"
 #include <string>
 #include <vector>
-#include <mutex>
 #include "custom_route.hpp"
+#include "tareas_db.hpp"
+#include "tarea_models.hpp"
+#include "request_arena.hpp"
+#include "feed_cambios.hpp"
+#include "sse/sse_manager.hpp"
+#include "sse/sse_conexion.hpp"
+#include <charconv>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <thread>
 
-// Estructura para representar una Tarea
-struct Tarea {
-    int id;
-    std::string titulo;
-    std::string descripcion;
-    bool completada;
-
-    crow::json::wvalue toJson() const {
-        crow::json::wvalue json;
-        json["id"] = id;
-        json["titulo"] = titulo;
-        json["descripcion"] = descripcion;
-        json["completada"] = completada;
-        return json;
-    }
-};
-
-// Base de datos en memoria
-class TareasDB {
-private:
-    std::vector<Tarea> tareas;
-    int siguiente_id;
-    std::mutex mtx;
-
-public:
-    TareasDB() : siguiente_id(1) {
-        // Datos de ejemplo
-        tareas.push_back({siguiente_id++, "Aprender Crow", "Crear una API REST con C++", false});
-        tareas.push_back({siguiente_id++, "Hacer ejercicio", "Correr 5km", true});
+#ifdef CONTAR_MALLOC
+// Cuenta las llamadas a operator new de cada hilo para /api/stats/memoria.
+// Solo para medir: compilar con -DCONTAR_MALLOC.
+void* operator new(std::size_t size) {
+    ++malloc_calls_hilo;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
     }
+    throw std::bad_alloc();
+}
 
-    Tarea crear(const std::string& titulo, const std::string& descripcion) {
-        std::lock_guard<std::mutex> lock(mtx);
-        Tarea nueva = {siguiente_id++, titulo, descripcion, false};
-        tareas.push_back(nueva);
-        return nueva;
-    }
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
 
-    std::vector<Tarea> obtenerTodas() {
-        std::lock_guard<std::mutex> lock(mtx);
-        return tareas;
-    }
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+#endif
 
-    std::pair<bool, Tarea> obtenerPorId(int id) {
-        std::lock_guard<std::mutex> lock(mtx);
-        for (const auto& tarea : tareas) {
-            if (tarea.id == id) {
-                return {true, tarea};
-            }
+// Lee limit, cursor y completada de la query string. Devuelve false si
+// algún valor no es válido.
+static bool leerConsulta(const crow::request& req, TareasConsulta& consulta) {
+    auto leerEntero = [](const char* valor, auto& destino) {
+        std::string_view texto(valor);
+        auto [ptr, ec] = std::from_chars(texto.data(), texto.data() + texto.size(), destino);
+        return !texto.empty() && ec == std::errc() && ptr == texto.data() + texto.size();
+    };
+
+    if (const char* limit = req.url_params.get("limit")) {
+        if (!leerEntero(limit, consulta.limite) || consulta.limite == 0) {
+            return false;
         }
-        return {false, {}};
     }
 
-    bool actualizar(int id, const std::string& titulo, const std::string& descripcion, bool completada) {
-        std::lock_guard<std::mutex> lock(mtx);
-        for (auto& tarea : tareas) {
-            if (tarea.id == id) {
-                tarea.titulo = titulo;
-                tarea.descripcion = descripcion;
-                tarea.completada = completada;
-                return true;
-            }
+    if (const char* cursor = req.url_params.get("cursor")) {
+        if (!leerEntero(cursor, consulta.cursor)) {
+            return false;
         }
-        return false;
     }
 
-    bool eliminar(int id) {
-        std::lock_guard<std::mutex> lock(mtx);
-        for (auto it = tareas.begin(); it != tareas.end(); ++it) {
-            if (it->id == id) {
-                tareas.erase(it);
-                return true;
-            }
+    if (const char* completada = req.url_params.get("completada")) {
+        std::string_view valor(completada);
+        if (valor == "true") {
+            consulta.completada = true;
+        } else if (valor == "false") {
+            consulta.completada = false;
+        } else {
+            return false;
         }
-        return false;
     }
-};
+
+    return true;
+}
+
+// Respuesta con un cuerpo JSON ya serializado
+static crow::response respuestaJson(int code, std::string body) {
+    crow::response res(code, std::move(body));
+    res.set_header("Content-Type", "application/json");
+    return res;
+}
+
+// Respuesta {"error": mensaje} sin pasar por crow::json::wvalue
+static crow::response respuestaError(int code, std::string_view mensaje) {
+    std::string body;
+    JsonWriter(body).raw("{\"error\":").string(mensaje).raw('}');
+    return respuestaJson(code, std::move(body));
+}
 
 int main() {
     crow::App<AuthenticationMiddleware> app;;    
     TareasDB db;
 
+    // Registrar los esquemas de los modelos antes de arrancar los workers
+    register_models<NuevaTareaModel, ActualizarTareaModel>();
+
+    // Feed de cambios (/api/tareas/changes): cada escritura de la base de
+    // datos se publica como evento SSE cuyo id es la versión que deja. Un
+    // cliente que no da abasto se desconecta en lugar de perder cambios y
+    // reanuda con Last-Event-ID desde el registro.
+    SseOptions opciones_cambios;
+    opciones_cambios.overflow = OverflowPolicy::DropClient;
+    opciones_cambios.log_capacity = 4096;
+    SSEManager cambios(opciones_cambios);
+    cambios.start_ids_after(db.versionActual());
+    FeedCambios feed_cambios(cambios, db.versionActual());
+    db.observarCambios([&feed_cambios](const CambioTarea& cambio) {
+        feed_cambios.registrar(cambio);
+    });
+
+    asio::io_context sse_io;
+    auto sse_work = asio::make_work_guard(sse_io);
+    std::thread sse_io_thread([&sse_io]() {
+        sse_io.run();
+    });
+    MantenimientoSse sse_mantenimiento(sse_io, cambios, [&feed_cambios]() {
+        feed_cambios.revisar();
+    });
+    sse_mantenimiento.iniciar();
+
      // Esta es TODA la solución que necesitas
     app.exception_handler([](crow::response& res) {
         try {
@@ -123,96 +151,136 @@ int main() {
     });
 
 
-    // GET /api/tareas - Obtener todas las tareas
+    // GET /api/tareas - Obtener tareas
+    // Parámetros opcionales: ?limit=N&cursor=ID (paginación por id) y
+    // ?completada=true|false (filtro). "total" es el número de tareas de
+    // la colección, como antes de paginar; "count" el de esta página y
+    // "limit" el límite aplicado, si lo hay. Sin limit, el cuerpo (y la
+    // memoria de la respuesta) crece con la colección: Crow lo envía
+    // entero al terminar, así que los listados grandes deben paginarse.
     CROW_ROUTE(app, "/api/tareas")
     .methods("GET"_method)
-    ([&db]() {
-        auto tareas = db.obtenerTodas();
-        crow::json::wvalue respuesta;
-        respuesta["total"] = tareas.size();
-        
-        std::vector<crow::json::wvalue> json_tareas;
-        for (const auto& tarea : tareas) {
-            json_tareas.push_back(tarea.toJson());
+    ([&db](const crow::request& req) {
+        ArenaScope arena;
+        TareasConsulta consulta;
+        if (!leerConsulta(req, consulta)) {
+            return respuestaError(400, "Parámetros de consulta inválidos");
         }
-        respuesta["tareas"] = std::move(json_tareas);
-        
-        return crow::response(200, respuesta);
+
+        // Se serializa directamente desde el snapshot, sin copiar tareas. El
+        // cuerpo va en un std::string que se mueve a la respuesta: en la
+        // arena habría que copiarlo y cada realojo dejaría bloques muertos.
+        uint64_t version = 0;
+        auto tareas = db.snapshot(&version);
+
+        std::string body;
+        body.reserve(64 * (consulta.limite ? std::min(consulta.limite, tareas->size()) : tareas->size()) + 64);
+        body += "{\"tareas\":[";
+        size_t count = 0;
+        auto siguiente = TareasDB::recorrer(*tareas, consulta, [&](const Tarea& tarea) {
+            if (count++ > 0) {
+                body += ',';
+            }
+            tarea.appendJson(body);
+        });
+        body += "],\"total\":";
+        JsonWriter json(body);
+        json.number(tareas->size());
+        json.raw(",\"count\":").number(count);
+        if (consulta.limite) {
+            json.raw(",\"limit\":").number(consulta.limite);
+        }
+        if (siguiente) {
+            json.raw(",\"siguiente_cursor\":").number(*siguiente);
+        }
+        json.raw('}');
+
+        // Versión desde la que seguir los cambios con /api/tareas/changes
+        auto res = respuestaJson(200, std::move(body));
+        res.set_header("X-Tareas-Version", std::to_string(version));
+        return res;
+    });
+
+    // GET /api/tareas/changes - Cambios en directo por SSE, en lugar de
+    // consultar el listado periódicamente. Cada evento "cambio" lleva
+    // {"op","id","version"} y su id SSE es la versión. Se reanuda desde
+    // ?version=N (p. ej. la cabecera X-Tareas-Version del listado) o con
+    // Last-Event-ID; si esa versión ya no está en el registro (o el feed
+    // tuvo que saltar un cambio que no llegó) se recibe un evento "reset" y
+    // hay que volver a leer el listado. Cada respuesta
+    // entrega un lote de cambios y termina (ver sse_conexion.hpp):
+    // EventSource reconecta con Last-Event-ID sin perder ninguno.
+    CROW_ROUTE(app, "/api/tareas/changes")
+    .methods("GET"_method)
+    ([&cambios, &sse_io](const crow::request& req, crow::response& res) {
+        iniciarRespuestaSse(res);
+        suscribirConexion(cambios, sse_io, res, {}, leerUltimoId(req, "version"));
     });
 
     // GET /api/tareas/:id - Obtener una tarea por ID
     CROW_ROUTE(app, "/api/tareas/<int>")
     .methods("GET"_method)
     ([&db](int id) {
-        auto [encontrada, tarea] = db.obtenerPorId(id);
+        ArenaScope arena;
+        auto tarea = db.obtenerPorId(id);
         
-        if (!encontrada) {
-            crow::json::wvalue error;
-            error["error"] = "Tarea no encontrada";
-            return crow::response(404, error);
+        if (!tarea) {
+            return respuestaError(404, "Tarea no encontrada");
         }
         
-        return crow::response(200, tarea.toJson());
+        std::string body;
+        tarea->appendJson(body);
+        return respuestaJson(200, std::move(body));
     });
 
     // POST /api/tareas - Crear una nueva tarea
     CROW_ROUTE(app, "/api/tareas")
     .methods("POST"_method)
     ([&db](const crow::request& req) {
-        auto json = crow::json::load(req.body);
+        ArenaScope arena;
+        NuevaTareaModel datos;
+        auto [valido, mensaje] = datos.from_json(req.body, arena.resource());
         
-        if (!json) {
-            crow::json::wvalue error;
-            error["error"] = "JSON inválido";
-            return crow::response(400, error);
+        if (!valido) {
+            return respuestaError(400, mensaje);
         }
-        
-        if (!json.has("titulo")) {
-            crow::json::wvalue error;
-            error["error"] = "El campo 'titulo' es requerido";
-            return crow::response(400, error);
+
+        auto validacion = datos.validate(arena.resource());
+        if (!validacion) {
+            return respuestaError(400, validacion.messages().front());
         }
         
-        std::string titulo = json["titulo"].s();
-        std::string descripcion = json.has("descripcion") ? std::string(json["descripcion"].s()) : std::string("");
+        auto nueva = db.crear(std::move(datos.titulo.value()), std::move(datos.descripcion.value()));
         
-        Tarea nueva = db.crear(titulo, descripcion);
+        std::string body = "{\"mensaje\":\"Tarea creada exitosamente\",\"tarea\":";
+        nueva->appendJson(body);
+        body += '}';
         
-        crow::json::wvalue respuesta;
-        respuesta["mensaje"] = "Tarea creada exitosamente";
-        respuesta["tarea"] = nueva.toJson();
-        
-        return crow::response(201, respuesta);
+        return respuestaJson(201, std::move(body));
     });
 
     // PUT /api/tareas/:id - Actualizar una tarea
     CROW_ROUTE(app, "/api/tareas/<int>")
     .methods("PUT"_method)
     ([&db](const crow::request& req, int id) {
-        auto json = crow::json::load(req.body);
+        ArenaScope arena;
+        ActualizarTareaModel datos;
+        auto [valido, mensaje] = datos.from_json(req.body, arena.resource());
         
-        if (!json) {
-            crow::json::wvalue error;
-            error["error"] = "JSON inválido";
-            return crow::response(400, error);
+        if (!valido) {
+            return respuestaError(400, mensaje);
         }
-        
-        if (!json.has("titulo") || !json.has("descripcion") || !json.has("completada")) {
-            crow::json::wvalue error;
-            error["error"] = "Faltan campos requeridos: titulo, descripcion, completada";
-            return crow::response(400, error);
+
+        auto validacion = datos.validate(arena.resource());
+        if (!validacion) {
+            return respuestaError(400, validacion.messages().front());
         }
         
-        std::string titulo = json["titulo"].s();
-        std::string descripcion = json["descripcion"].s();
-        bool completada = json["completada"].b();
-        
-        bool actualizada = db.actualizar(id, titulo, descripcion, completada);
+        bool actualizada = db.actualizar(id, std::move(datos.titulo.value()),
+                                         std::move(datos.descripcion.value()), datos.completada.value());
         
         if (!actualizada) {
-            crow::json::wvalue error;
-            error["error"] = "Tarea no encontrada";
-            return crow::response(404, error);
+            return respuestaError(404, "Tarea no encontrada");
         }
         
         return crow::response(204);
@@ -223,20 +291,45 @@ int main() {
     .methods("DELETE"_method)
     
     ([&db](int id) {
+        ArenaScope arena;
         bool eliminada = db.eliminar(id);
         
         if (!eliminada) {
-            crow::json::wvalue error;
-            error["error"] = "Tarea no encontrada";
-            return crow::response(404, error);
+            return respuestaError(404, "Tarea no encontrada");
         }
         
         return crow::response(204);
     });
 
+    // GET /api/stats/memoria - Tráfico del asignador en las peticiones CRUD
+    CROW_ROUTE(app, "/api/stats/memoria")
+    .methods("GET"_method)
+    ([] {
+        const AllocStats& stats = AllocStats::global();
+        auto leer = [](const std::atomic<uint64_t>& contador) {
+            return contador.load(std::memory_order_relaxed);
+        };
+
+        std::string body;
+        JsonWriter(body)
+            .raw("{\"peticiones\":").number(leer(stats.peticiones))
+            .raw(",\"arena_asignaciones\":").number(leer(stats.arena_asignaciones))
+            .raw(",\"arena_bytes\":").number(leer(stats.arena_bytes))
+            .raw(",\"desbordes\":").number(leer(stats.desbordes))
+            .raw(",\"desbordes_bytes\":").number(leer(stats.desbordes_bytes))
+            .raw(",\"malloc_calls\":").number(leer(stats.malloc_calls))
+            .raw('}');
+        return respuestaJson(200, std::move(body));
+    });
+
     std::cout << "API REST corriendo en http://localhost:8080\n";
     
     app.port(8080).multithreaded().run();
+
+    feed_cambios.detener();
+    sse_mantenimiento.detener();
+    sse_work.reset();
+    sse_io_thread.join();
     
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,460 @@
+#ifndef PATTERN_CACHE_HPP
+#define PATTERN_CACHE_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Motor rápido para los patrones más habituales en validación: secuencias
+// de átomos (literal, '.', clase [...] o \d \w \s) con cuantificador
+// (*, +, ?, {n}, {n,}, {n,m}) y anclas ^ $ opcionales. Por ejemplo:
+//   ^[a-zA-Z0-9_]{3,20}$
+//   ^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}$
+// Cualquier otra construcción (grupos, alternativas...) no se compila y se
+// usa std::regex.
+class FastPattern
+{
+public:
+    enum class Result
+    {
+        Match,
+        NoMatch,
+        Unknown // Presupuesto de backtracking agotado: decidir con std::regex
+    };
+
+    static std::optional<FastPattern> compile(std::string_view pattern)
+    {
+        FastPattern compiled;
+        size_t pos = 0;
+
+        if (pos < pattern.size() && pattern[pos] == '^')
+        {
+            ++pos;
+        }
+
+        while (pos < pattern.size())
+        {
+            // '$' solo se admite como ancla final
+            if (pattern[pos] == '$')
+            {
+                if (pos + 1 != pattern.size())
+                {
+                    return std::nullopt;
+                }
+                break;
+            }
+
+            Atom atom;
+            if (!parse_atom(pattern, pos, atom.chars) || !parse_quantifier(pattern, pos, atom))
+            {
+                return std::nullopt;
+            }
+            compiled.atoms_.push_back(atom);
+        }
+
+        return compiled;
+    }
+
+    // Coincidencia completa (misma semántica que std::regex_match)
+    Result match(std::string_view value) const
+    {
+        size_t budget = max_steps_per_char * (value.size() + 1) * (atoms_.size() + 1);
+        return match_from(0, value, 0, budget);
+    }
+
+private:
+    static constexpr size_t unbounded = std::numeric_limits<size_t>::max();
+    static constexpr size_t max_steps_per_char = 8;
+
+    using CharSet = std::array<uint64_t, 4>;
+
+    struct Atom
+    {
+        CharSet chars{};
+        size_t min = 1;
+        size_t max = 1;
+    };
+
+    std::vector<Atom> atoms_;
+
+    static void set(CharSet &chars, unsigned char c)
+    {
+        chars[c >> 6] |= uint64_t{1} << (c & 63);
+    }
+
+    static bool test(const CharSet &chars, unsigned char c)
+    {
+        return (chars[c >> 6] >> (c & 63)) & 1;
+    }
+
+    static void set_range(CharSet &chars, unsigned char from, unsigned char to)
+    {
+        for (unsigned c = from; c <= to; ++c)
+        {
+            set(chars, static_cast<unsigned char>(c));
+        }
+    }
+
+    static void negate(CharSet &chars)
+    {
+        for (auto &word : chars)
+        {
+            word = ~word;
+        }
+    }
+
+    // \d \w \s y sus negaciones; devuelve false si no es una clase abreviada
+    static bool shorthand_class(char c, CharSet &chars)
+    {
+        CharSet shorthand{};
+        switch (c)
+        {
+        case 'd':
+        case 'D':
+            set_range(shorthand, '0', '9');
+            break;
+        case 'w':
+        case 'W':
+            set_range(shorthand, 'a', 'z');
+            set_range(shorthand, 'A', 'Z');
+            set_range(shorthand, '0', '9');
+            set(shorthand, '_');
+            break;
+        case 's':
+        case 'S':
+            for (char space : {' ', '\t', '\n', '\r', '\f', '\v'})
+            {
+                set(shorthand, static_cast<unsigned char>(space));
+            }
+            break;
+        default:
+            return false;
+        }
+
+        if (c == 'D' || c == 'W' || c == 'S')
+        {
+            negate(shorthand);
+        }
+        for (size_t i = 0; i < chars.size(); ++i)
+        {
+            chars[i] |= shorthand[i];
+        }
+        return true;
+    }
+
+    // Escapes que representan un carácter literal
+    static bool escaped_literal(char c)
+    {
+        static constexpr std::string_view literals = ".^$|?*+()[]{}\\/-";
+        return literals.find(c) != std::string_view::npos;
+    }
+
+    static bool parse_class(std::string_view pattern, size_t &pos, CharSet &chars)
+    {
+        ++pos; // '['
+        bool negated = pos < pattern.size() && pattern[pos] == '^';
+        if (negated)
+        {
+            ++pos;
+        }
+
+        // En ECMAScript "[]" y "[^]" son clases especiales: se dejan a std::regex
+        if (pos < pattern.size() && pattern[pos] == ']')
+        {
+            return false;
+        }
+
+        while (pos < pattern.size() && pattern[pos] != ']')
+        {
+            unsigned char from = static_cast<unsigned char>(pattern[pos]);
+
+            if (from == '\\')
+            {
+                if (++pos >= pattern.size())
+                {
+                    return false;
+                }
+                if (shorthand_class(pattern[pos], chars))
+                {
+                    ++pos;
+                    continue;
+                }
+                if (!escaped_literal(pattern[pos]))
+                {
+                    return false;
+                }
+                from = static_cast<unsigned char>(pattern[pos]);
+            }
+            else if (from == '[')
+            {
+                return false; // [:alpha:] y similares
+            }
+            ++pos;
+
+            // Rango a-z (un '-' final es literal)
+            if (pos + 1 < pattern.size() && pattern[pos] == '-' && pattern[pos + 1] != ']')
+            {
+                unsigned char to = static_cast<unsigned char>(pattern[pos + 1]);
+                if (to == '\\' || to < from)
+                {
+                    return false;
+                }
+                set_range(chars, from, to);
+                pos += 2;
+            }
+            else
+            {
+                set(chars, from);
+            }
+        }
+
+        if (pos >= pattern.size())
+        {
+            return false; // Falta ']'
+        }
+        ++pos;
+
+        if (negated)
+        {
+            negate(chars);
+        }
+        return true;
+    }
+
+    static bool parse_atom(std::string_view pattern, size_t &pos, CharSet &chars)
+    {
+        char c = pattern[pos];
+        switch (c)
+        {
+        case '[':
+            return parse_class(pattern, pos, chars);
+        case '.':
+            // En ECMAScript '.' no acepta terminadores de línea
+            negate(chars);
+            chars['\n' >> 6] &= ~(uint64_t{1} << ('\n' & 63));
+            chars['\r' >> 6] &= ~(uint64_t{1} << ('\r' & 63));
+            ++pos;
+            return true;
+        case '\\':
+            if (pos + 1 >= pattern.size())
+            {
+                return false;
+            }
+            c = pattern[pos + 1];
+            pos += 2;
+            if (shorthand_class(c, chars))
+            {
+                return true;
+            }
+            if (!escaped_literal(c))
+            {
+                return false;
+            }
+            set(chars, static_cast<unsigned char>(c));
+            return true;
+        case '(':
+        case ')':
+        case '|':
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+        case '}':
+        case ']':
+        case '^':
+            return false;
+        default:
+            set(chars, static_cast<unsigned char>(c));
+            ++pos;
+            return true;
+        }
+    }
+
+    static bool parse_number(std::string_view pattern, size_t &pos, size_t &value)
+    {
+        size_t start = pos;
+        value = 0;
+        while (pos < pattern.size() && pattern[pos] >= '0' && pattern[pos] <= '9' && pos - start < 6)
+        {
+            value = value * 10 + static_cast<size_t>(pattern[pos] - '0');
+            ++pos;
+        }
+        return pos > start;
+    }
+
+    static bool parse_quantifier(std::string_view pattern, size_t &pos, Atom &atom)
+    {
+        if (pos >= pattern.size())
+        {
+            return true;
+        }
+
+        switch (pattern[pos])
+        {
+        case '*':
+            atom.min = 0;
+            atom.max = unbounded;
+            ++pos;
+            break;
+        case '+':
+            atom.max = unbounded;
+            ++pos;
+            break;
+        case '?':
+            atom.min = 0;
+            ++pos;
+            break;
+        case '{':
+        {
+            ++pos;
+            if (!parse_number(pattern, pos, atom.min))
+            {
+                return false;
+            }
+            atom.max = atom.min;
+            if (pos < pattern.size() && pattern[pos] == ',')
+            {
+                ++pos;
+                atom.max = unbounded;
+                if (pos < pattern.size() && pattern[pos] != '}' && !parse_number(pattern, pos, atom.max))
+                {
+                    return false;
+                }
+            }
+            if (pos >= pattern.size() || pattern[pos] != '}' || atom.max < atom.min)
+            {
+                return false;
+            }
+            ++pos;
+            break;
+        }
+        default:
+            return true;
+        }
+
+        // Cuantificadores perezosos o anidados: se deja a std::regex
+        return pos >= pattern.size() ||
+               (pattern[pos] != '?' && pattern[pos] != '*' && pattern[pos] != '+' && pattern[pos] != '{');
+    }
+
+    // Backtracking voraz con presupuesto de pasos
+    Result match_from(size_t index, std::string_view value, size_t pos, size_t &budget) const
+    {
+        if (index == atoms_.size())
+        {
+            return pos == value.size() ? Result::Match : Result::NoMatch;
+        }
+
+        const Atom &atom = atoms_[index];
+        size_t count = 0;
+        while (count < atom.max && pos + count < value.size() &&
+               test(atom.chars, static_cast<unsigned char>(value[pos + count])))
+        {
+            ++count;
+        }
+
+        for (; count + 1 > atom.min; --count)
+        {
+            if (budget-- == 0)
+            {
+                return Result::Unknown;
+            }
+
+            Result result = match_from(index + 1, value, pos + count, budget);
+            if (result != Result::NoMatch)
+            {
+                return result;
+            }
+            if (count == 0)
+            {
+                break;
+            }
+        }
+
+        return Result::NoMatch;
+    }
+};
+
+// Patrón compilado una sola vez: std::regex y, si el patrón lo permite,
+// su versión FastPattern
+class CompiledPattern
+{
+public:
+    explicit CompiledPattern(const std::string &pattern)
+        : regex_(pattern, std::regex::ECMAScript | std::regex::optimize),
+          fast_(FastPattern::compile(pattern)) {}
+
+    bool matches(const std::string &value) const
+    {
+        if (fast_)
+        {
+            FastPattern::Result result = fast_->match(value);
+            if (result != FastPattern::Result::Unknown)
+            {
+                return result == FastPattern::Result::Match;
+            }
+        }
+        return std::regex_match(value, regex_);
+    }
+
+    bool has_fast_path() const
+    {
+        return fast_.has_value();
+    }
+
+private:
+    std::regex regex_;
+    std::optional<FastPattern> fast_;
+};
+
+// Caché global de patrones: cada patrón distinto se compila una sola vez y
+// se comparte entre todos los validadores que lo usan.
+class PatternCache
+{
+public:
+    // Lanza std::regex_error si el patrón no es válido (no se cachea)
+    static std::shared_ptr<const CompiledPattern> get(const std::string &pattern)
+    {
+        PatternCache &cache = instance();
+        std::lock_guard<std::mutex> lock(cache.mtx_);
+
+        auto it = cache.patterns_.find(pattern);
+        if (it != cache.patterns_.end())
+        {
+            return it->second;
+        }
+
+        auto compiled = std::make_shared<const CompiledPattern>(pattern);
+        cache.patterns_.emplace(pattern, compiled);
+        return compiled;
+    }
+
+    static void clear()
+    {
+        PatternCache &cache = instance();
+        std::lock_guard<std::mutex> lock(cache.mtx_);
+        cache.patterns_.clear();
+    }
+
+private:
+    PatternCache() = default;
+
+    static PatternCache &instance()
+    {
+        static PatternCache cache;
+        return cache;
+    }
+
+    std::mutex mtx_;
+    std::unordered_map<std::string, std::shared_ptr<const CompiledPattern>> patterns_;
+};
+
+#endif // PATTERN_CACHE_HPP
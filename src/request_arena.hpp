@@ -0,0 +1,125 @@
+#ifndef REQUEST_ARENA_HPP
+#define REQUEST_ARENA_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+// Llamadas a operator new del hilo actual. Solo se incrementa si el
+// ejecutable reemplaza el operator new global para contarlas (ver main.cpp,
+// -DCONTAR_MALLOC); si no, se queda en 0.
+inline thread_local uint64_t malloc_calls_hilo = 0;
+
+// Contadores globales de tráfico del asignador. Cada hilo acumula los
+// suyos durante la petición y los vuelca aquí una sola vez al terminarla.
+struct AllocStats {
+    std::atomic<uint64_t> peticiones{0};
+    std::atomic<uint64_t> arena_asignaciones{0};  // Reservas servidas por la arena
+    std::atomic<uint64_t> arena_bytes{0};
+    std::atomic<uint64_t> desbordes{0};           // Bloques que la arena pidió al heap
+    std::atomic<uint64_t> desbordes_bytes{0};
+    std::atomic<uint64_t> malloc_calls{0};        // operator new durante peticiones (-DCONTAR_MALLOC)
+
+    static AllocStats& global() {
+        static AllocStats stats;
+        return stats;
+    }
+};
+
+// Arena monotónica por hilo para los objetos de vida corta de una petición
+// (parser, validación, escritura del JSON). Empieza en un buffer propio y
+// solo recurre al heap si la petición lo agota; reset() lo libera todo de
+// golpe. Los handlers de Crow atienden una petición cada vez por hilo, así
+// que basta con una arena por hilo.
+class RequestArena {
+public:
+    static constexpr size_t buffer_size = 16 * 1024;
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    static RequestArena& local() {
+        thread_local RequestArena arena;
+        return arena;
+    }
+
+    std::pmr::memory_resource* resource() {
+        return &counted_;
+    }
+
+    // Libera todo lo reservado y vuelca los contadores de la petición
+    void reset() {
+        monotonic_.release();
+
+        AllocStats& stats = AllocStats::global();
+        stats.arena_asignaciones.fetch_add(counted_.asignaciones, std::memory_order_relaxed);
+        stats.arena_bytes.fetch_add(counted_.bytes, std::memory_order_relaxed);
+        stats.desbordes.fetch_add(upstream_.asignaciones, std::memory_order_relaxed);
+        stats.desbordes_bytes.fetch_add(upstream_.bytes, std::memory_order_relaxed);
+        counted_.asignaciones = counted_.bytes = 0;
+        upstream_.asignaciones = upstream_.bytes = 0;
+    }
+
+private:
+    // Recurso que cuenta las reservas que le llegan y las delega en 'next'.
+    // Los contadores no son atómicos: cada arena pertenece a un solo hilo.
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        explicit CountingResource(std::pmr::memory_resource* next) : next_(next) {}
+
+        uint64_t asignaciones = 0;
+        uint64_t bytes = 0;
+
+    private:
+        std::pmr::memory_resource* next_;
+
+        void* do_allocate(size_t size, size_t alignment) override {
+            ++asignaciones;
+            bytes += size;
+            return next_->allocate(size, alignment);
+        }
+
+        void do_deallocate(void* p, size_t size, size_t alignment) override {
+            next_->deallocate(p, size, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    RequestArena() = default;
+
+    alignas(std::max_align_t) std::byte buffer_[buffer_size];
+    CountingResource upstream_{std::pmr::new_delete_resource()};
+    std::pmr::monotonic_buffer_resource monotonic_{buffer_, buffer_size, &upstream_};
+    CountingResource counted_{&monotonic_};
+};
+
+// Delimita una petición: da acceso a la arena del hilo y la reinicia al
+// salir del handler, una vez construida la respuesta.
+class ArenaScope {
+public:
+    ArenaScope() : arena_(RequestArena::local()), malloc_inicio_(malloc_calls_hilo) {}
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    ~ArenaScope() {
+        AllocStats& stats = AllocStats::global();
+        stats.peticiones.fetch_add(1, std::memory_order_relaxed);
+        stats.malloc_calls.fetch_add(malloc_calls_hilo - malloc_inicio_, std::memory_order_relaxed);
+        arena_.reset();
+    }
+
+    std::pmr::memory_resource* resource() {
+        return arena_.resource();
+    }
+
+private:
+    RequestArena& arena_;
+    uint64_t malloc_inicio_;
+};
+
+#endif // REQUEST_ARENA_HPP
@@ -1,77 +1,59 @@
 #include "crow.h"
+#include "sse_manager.hpp"
+#include "sse_dispatcher.hpp"
+#include "sse_conexion.hpp"
 #include <thread>
-#include <atomic>
-#include <chrono>
-#include <sstream>
+#include <string>
+#include <string_view>
 #include <vector>
-#include <mutex>
-#include <ctime>
 
-// Manejador de conexiones SSE
-class SSEManager {
-private:
-    std::vector<crow::response*> clients;
-    std::mutex clients_mutex;
-    std::atomic<bool> running{true};
-    std::thread broadcast_thread;
-
-public:
-    SSEManager() {
-        // Hilo que envía eventos cada segundo
-        broadcast_thread = std::thread([this]() {
-            int counter = 0;
-            while(running) {
-                broadcast_event("counter", std::to_string(counter++));
-                std::this_thread::sleep_for(std::chrono::seconds(1));
-            }
-        });
+// Temas pedidos en ?topics=a,b (como mucho max_temas; vacío = todos)
+static std::vector<std::string> leerTemas(const crow::request& req) {
+    constexpr size_t max_temas = 16;
+    std::vector<std::string> temas;
+    const char* param = req.url_params.get("topics");
+    if (!param) {
+        return temas;
     }
 
-    ~SSEManager() {
-        running = false;
-        if(broadcast_thread.joinable()) {
-            broadcast_thread.join();
+    std::string_view lista(param);
+    while (!lista.empty() && temas.size() < max_temas) {
+        size_t coma = lista.find(',');
+        std::string_view tema = lista.substr(0, coma);
+        if (!tema.empty()) {
+            temas.emplace_back(tema);
         }
-    }
-
-    void add_client(crow::response* res) {
-        
-        std::lock_guard<std::mutex> lock(clients_mutex);
-        clients.push_back(res);
-    }
-
-    void remove_client(crow::response* res) {
-        std::lock_guard<std::mutex> lock(clients_mutex);
-        clients.erase(
-            std::remove(clients.begin(), clients.end(), res),
-            clients.end()
-        );
-    }
-
-    void broadcast_event(const std::string& event, const std::string& data) {
-        std::lock_guard<std::mutex> lock(clients_mutex);
-        
-        std::ostringstream oss;
-        oss << "event: " << event << "\n"
-            << "data: " << data << "\n"
-            << "id: " << std::time(nullptr) << "\n\n";
-        
-        std::string message = oss.str();
-        
-        // Enviar a todos los clientes conectados
-        for(auto* client : clients) {
-            try {
-                client->write(message);
-            } catch(...) {
-                // Cliente desconectado
-            }
+        if (coma == std::string_view::npos) {
+            break;
         }
+        lista.remove_prefix(coma + 1);
     }
-};
+    return temas;
+}
 
 int main() {
     crow::SimpleApp app;
-    SSEManager sse_manager;
+    SSEManager sse_manager({256, OverflowPolicy::DropOldest});
+
+    // Publicación desde cualquier hilo: post() encola sin bloquear y el
+    // despachador publica por lotes
+    SseDispatcher sse_eventos(sse_manager);
+
+    // Bucle de E/S de las conexiones SSE: cada suscriptor se drena aquí
+    // cuando tiene eventos pendientes, fuera del hilo que hace el broadcast
+    asio::io_context sse_io;
+    auto sse_work = asio::make_work_guard(sse_io);
+    std::thread sse_io_thread([&sse_io]() {
+        sse_io.run();
+    });
+
+    // Cada segundo, desde el mismo bucle de E/S: latido, baja de
+    // suscriptores inactivos y el contador de la demo
+    int counter = 0;
+    MantenimientoSse sse_mantenimiento(sse_io, sse_manager, [&sse_eventos, &counter]() {
+        sse_eventos.post("counter", std::to_string(counter++));
+    });
+    sse_mantenimiento.iniciar();
 
     // Endpoint para servir el HTML
     CROW_ROUTE(app, "/")
@@ -184,6 +166,11 @@ int main() {
                 addLog('Evento personalizado: ' + e.data);
             });
 
+            // El servidor ya no tiene todos los eventos perdidos
+            eventSource.addEventListener('reset', function() {
+                addLog('Eventos perdidos durante la desconexion: estado reiniciado');
+            });
+
             eventSource.onmessage = function(e) {
                 addLog('Mensaje: ' + e.data);
             };
@@ -222,28 +209,30 @@ int main() {
         return page;
     });
 
-    // Endpoint SSE
+    // Endpoint SSE: /events?topics=a,b recibe solo los eventos de esos temas
     CROW_ROUTE(app, "/events")
-    ([&sse_manager](const crow::request& req, crow::response& res) {
-        res.set_header("Content-Type", "text/event-stream");
-        res.set_header("Cache-Control", "no-cache");
-        res.set_header("Connection", "keep-alive");
-        res.set_header("Access-Control-Allow-Origin", "*");
-        
-        // Agregar cliente
-        sse_manager.add_client(&res);
-        
-        // Enviar mensaje inicial
-        res.write("event: message\ndata: Conectado al servidor SSE\n\n");
-        
-        // Mantener la conexión abierta
-        //res.end();
+    ([&sse_manager, &sse_io](const crow::request& req, crow::response& res) {
+        iniciarRespuestaSse(res);
+
+        // Un cliente que reconecta envía el id del último evento recibido y
+        // se le reenvía lo que se perdió
+        auto ultimo_id = leerUltimoId(req);
+
+        // Enviar mensaje inicial (solo en la primera conexión: EventSource
+        // reconecta tras cada respuesta)
+        if (!ultimo_id) {
+            res.write("event: message\ndata: Conectado al servidor SSE\n\n");
+        }
+
+        // La respuesta queda abierta hasta que haya algo que entregar y la
+        // termina suscribirConexion
+        suscribirConexion(sse_manager, sse_io, res, leerTemas(req), ultimo_id);
     });
 
     // Endpoint para disparar eventos personalizados
     CROW_ROUTE(app, "/trigger-event").methods("POST"_method)
-    ([&sse_manager](const crow::request& req) {
-        sse_manager.broadcast_event("custom", "Evento disparado por el usuario!");
+    ([&sse_eventos](const crow::request& req) {
+        sse_eventos.post("custom", "Evento disparado por el usuario!");
         return crow::response(200, "OK");
     });
 
@@ -251,6 +240,11 @@ int main() {
     std::cout << "Abre tu navegador y visita la URL\n";
     
     app.port(8080).multithreaded().run();
+
+    sse_eventos.stop();
+    sse_mantenimiento.detener();
+    sse_work.reset();
+    sse_io_thread.join();
     
     return 0;
 }
\ No newline at end of file
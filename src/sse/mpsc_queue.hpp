@@ -0,0 +1,92 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <utility>
+
+// Cola MPSC sin bloqueos (algoritmo intrusivo de Dmitry Vyukov). push() es
+// wait-free y se puede llamar desde cualquier hilo: un exchange atómico y
+// un store. pop() y empty() solo los llama el único consumidor.
+//
+// Si un productor está a medias (entre el exchange y el store del enlace),
+// pop() devuelve false aunque haya elementos detrás; ese productor termina
+// enseguida, así que el consumidor solo tiene que volver a intentarlo.
+template<typename T>
+class MpscQueue {
+public:
+    MpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    ~MpscQueue() {
+        T value;
+        while (pop(value)) {
+        }
+    }
+
+    void push(T value) {
+        push_node(new Node(std::move(value)));
+    }
+
+    // Saca el elemento más antiguo. Solo el consumidor.
+    bool pop(T& out) {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &stub_) {
+            if (!next) {
+                return false;
+            }
+            tail_ = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (!next) {
+            // 'tail' es el último enlazado: si no es también la cabeza, un
+            // productor está a medias. Si lo es, se reinserta el nodo vacío
+            // para poder sacar 'tail' sin dejar la cola sin nodos.
+            if (tail != head_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            push_node(&stub_);
+            next = tail->next.load(std::memory_order_acquire);
+            if (!next) {
+                return false;
+            }
+        }
+
+        tail_ = next;
+        out = std::move(tail->value);
+        delete tail;
+        return true;
+    }
+
+    // Sin elementos ni productores a medias. Solo el consumidor.
+    bool empty() const {
+        return tail_ == &stub_ && head_.load(std::memory_order_seq_cst) == &stub_;
+    }
+
+private:
+    struct Node {
+        Node() = default;
+        explicit Node(T v) : value(std::move(v)) {}
+
+        std::atomic<Node*> next{nullptr};
+        T value;
+    };
+
+    void push_node(Node* node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        // seq_cst para que un consumidor que se va a dormir (ver
+        // SseDispatcher) no pueda dejar de ver este push
+        Node* prev = head_.exchange(node, std::memory_order_seq_cst);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    alignas(64) std::atomic<Node*> head_;   // Productores
+    alignas(64) Node* tail_;                // Consumidor
+    Node stub_;
+};
+
+#endif // MPSC_QUEUE_HPP
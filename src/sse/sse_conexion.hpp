@@ -0,0 +1,161 @@
+#ifndef SSE_CONEXION_HPP
+#define SSE_CONEXION_HPP
+
+#include "crow.h"
+#include "sse_manager.hpp"
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Pegamento entre Crow y SSEManager, compartido por los servidores que
+// publican streams SSE. Las conexiones se drenan desde un io_context
+// propio, fuera de los hilos que publican.
+//
+// Crow 1.2 no deja escribir en el socket de una respuesta en curso:
+// response::write() solo añade al cuerpo, que sale entero al llamar a
+// end(). Por eso cada respuesta SSE es una encuesta larga: queda abierta
+// hasta que el suscriptor tiene eventos que entregar (o un "reset"), los
+// escribe en un único lote, termina con end() y se da de baja. EventSource
+// reconecta solo, tras 'retry', enviando Last-Event-ID, y el registro del
+// manager le reenvía lo publicado mientras tanto. El cuerpo de una
+// respuesta queda acotado por la cola del suscriptor.
+//
+// El latido no termina la respuesta: la conexión solo comprueba su socket
+// y deja el comentario en el cuerpo, que saldrá con el siguiente lote. Un
+// cliente sin eventos reconecta cada idle_timeout (60 s por defecto), que
+// es también lo que tarda en desaparecer un cliente caído.
+//
+// Latencia: un evento llega en microsegundos al cliente que ya espera con
+// la respuesta abierta. Tras cada lote, el cliente tarda 'retry' más un
+// viaje de ida y vuelta en volver a estar suscrito; lo publicado mientras
+// tanto sale agrupado al reconectar. Con tráfico continuo cada cliente
+// recibe, por tanto, como mucho un lote cada reintento_sse + RTT, y ese es
+// el suelo de latencia de un evento que llega justo después de otro.
+
+// Espera del navegador antes de reconectar tras cada respuesta
+inline constexpr std::chrono::milliseconds reintento_sse{250};
+
+// Estado de una conexión SSE. Solo se toca desde el bucle de E/S: una vez
+// terminada, 'res' ya no es válido y no se vuelve a escribir en él.
+struct ConexionSse {
+    crow::response* res;
+    bool terminada = false;
+};
+
+// Cabeceras de un stream SSE
+inline void iniciarRespuestaSse(crow::response& res) {
+    res.set_header("Content-Type", "text/event-stream");
+    res.set_header("Cache-Control", "no-cache");
+    res.set_header("Connection", "keep-alive");
+    res.set_header("Access-Control-Allow-Origin", "*");
+}
+
+// Id desde el que reanudar: la cabecera Last-Event-ID (la envía EventSource
+// al reconectar) o, si no está, el parámetro 'param' de la URL
+inline std::optional<uint64_t> leerUltimoId(const crow::request& req, const char* param = nullptr) {
+    std::string valor = req.get_header_value("Last-Event-ID");
+    if (valor.empty() && param) {
+        if (const char* texto = req.url_params.get(param)) {
+            valor = texto;
+        }
+    }
+
+    uint64_t id = 0;
+    auto [ptr, ec] = std::from_chars(valor.data(), valor.data() + valor.size(), id);
+    if (valor.empty() || ec != std::errc() || ptr != valor.data() + valor.size()) {
+        return std::nullopt;
+    }
+    return id;
+}
+
+// Da de alta la conexión 'res' en 'manager'. El broadcast solo encola y
+// despierta a la conexión, que desde 'io' escribe lo pendiente y, si había
+// eventos, se da de baja; si solo era el latido sigue esperando. Cualquier
+// baja (tras escribir, cliente caído, desbordamiento o inactividad) termina
+// la respuesta con un último bloque "retry"/"id": el id es el cursor del
+// suscriptor, así que el cliente reanuda desde ahí aunque no haya recibido
+// ningún evento con id.
+inline std::shared_ptr<SseSubscriber> suscribirConexion(SSEManager& manager, asio::io_context& io,
+                                                        crow::response& res,
+                                                        std::vector<std::string> temas = {},
+                                                        std::optional<uint64_t> ultimo_id = std::nullopt) {
+    auto conexion = std::make_shared<ConexionSse>(ConexionSse{&res});
+    auto despertar = [&io, &manager, conexion](const std::shared_ptr<SseSubscriber>& suscriptor) {
+        asio::post(io, [&manager, suscriptor, conexion]() {
+            if (conexion->terminada) {
+                return;
+            }
+            if (!conexion->res->is_alive()) {
+                manager.unsubscribe(suscriptor);
+                return;
+            }
+            size_t eventos = suscriptor->drain([&conexion](const std::string& mensaje) {
+                conexion->res->write(mensaje);
+            });
+            if (eventos > 0) {
+                manager.unsubscribe(suscriptor);
+            }
+        });
+    };
+    auto cerrar = [&io, conexion](const std::shared_ptr<SseSubscriber>& suscriptor) {
+        asio::post(io, [suscriptor, conexion]() {
+            if (conexion->terminada) {
+                return;
+            }
+            conexion->terminada = true;
+            std::string cierre = "retry: " + std::to_string(reintento_sse.count()) +
+                                 "\nid: " + std::to_string(suscriptor->cursor()) + "\n\n";
+            conexion->res->write(cierre);
+            conexion->res->end();
+        });
+    };
+    return manager.subscribe(despertar, std::move(temas), ultimo_id, cerrar);
+}
+
+// Cada segundo, desde 'io': latido y baja de suscriptores inactivos, más
+// 'tarea' si se indica
+class MantenimientoSse {
+public:
+    MantenimientoSse(asio::io_context& io, SSEManager& manager, std::function<void()> tarea = {})
+        : io_(io), manager_(manager), tarea_(std::move(tarea)), timer_(io) {}
+
+    void iniciar() {
+        asio::post(io_, [this]() {
+            programar();
+        });
+    }
+
+    // Cancela el timer para que 'io' pueda terminar
+    void detener() {
+        asio::post(io_, [this]() {
+            timer_.cancel();
+        });
+    }
+
+private:
+    void programar() {
+        timer_.expires_after(std::chrono::seconds(1));
+        timer_.async_wait([this](const asio::error_code& ec) {
+            if (ec) {
+                return; // Cancelado al cerrar
+            }
+            manager_.maintain();
+            if (tarea_) {
+                tarea_();
+            }
+            programar();
+        });
+    }
+
+    asio::io_context& io_;
+    SSEManager& manager_;
+    std::function<void()> tarea_;
+    asio::steady_timer timer_;
+};
+
+#endif // SSE_CONEXION_HPP
@@ -0,0 +1,171 @@
+#ifndef SSE_DISPATCHER_HPP
+#define SSE_DISPATCHER_HPP
+
+#include "mpsc_queue.hpp"
+#include "sse_manager.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Despachador por lotes dirigido por eventos. post() se puede llamar desde
+// cualquier hilo (un handler, una mutación de la base de datos...): deja
+// el elemento en una cola MPSC sin bloqueos y vuelve enseguida. Un único
+// hilo despachador saca lo acumulado y se lo pasa a 'handler' por lotes
+// (como mucho max_batch), en el orden en que se encolaron.
+//
+// El despachador espera un momento activo antes de dormirse (salvo con un
+// solo núcleo, donde solo le quitaría tiempo a los productores) y los
+// productores solo lo despiertan (futex) si de verdad está dormido: con
+// carga, publicar no hace ninguna llamada al sistema.
+template<typename T>
+class BatchDispatcher {
+public:
+    using Handler = std::function<void(std::vector<T>&)>;
+
+    struct Stats {
+        uint64_t posted = 0;
+        uint64_t published = 0;
+        uint64_t batches = 0;
+    };
+
+    explicit BatchDispatcher(Handler handler, size_t max_batch = 256,
+                             std::chrono::microseconds spin = std::chrono::microseconds(50))
+        : handler_(std::move(handler)), max_batch_(max_batch ? max_batch : 1),
+          spin_(std::thread::hardware_concurrency() > 1 ? spin : std::chrono::microseconds(0)) {
+        thread_ = std::thread([this]() {
+            run();
+        });
+    }
+
+    BatchDispatcher(const BatchDispatcher&) = delete;
+    BatchDispatcher& operator=(const BatchDispatcher&) = delete;
+
+    ~BatchDispatcher() {
+        stop();
+    }
+
+    // Encola un elemento. Thread-safe y sin bloqueos.
+    void post(T item) {
+        queue_.push(std::move(item));
+        posted_.fetch_add(1, std::memory_order_relaxed);
+        wake();
+    }
+
+    // Entrega lo que quede en la cola y termina el hilo. Idempotente.
+    void stop() {
+        if (stopping_.exchange(true)) {
+            return;
+        }
+        wake();
+        thread_.join();
+    }
+
+    Stats stats() const {
+        return {posted_.load(std::memory_order_relaxed), published_.load(std::memory_order_relaxed),
+                batches_.load(std::memory_order_relaxed)};
+    }
+
+private:
+    void wake() {
+        // El push (exchange seq_cst en la cola) y esta lectura forman pareja
+        // con el store de sleeping_ y la consulta de la cola en run(): o el
+        // productor ve al despachador dormido o el despachador ve el evento
+        if (sleeping_.load(std::memory_order_seq_cst) && sleeping_.exchange(false)) {
+            sleeping_.notify_one();
+        }
+    }
+
+    void run() {
+        std::vector<T> batch;
+        batch.reserve(max_batch_);
+        T item;
+
+        while (true) {
+            while (batch.size() < max_batch_ && queue_.pop(item)) {
+                batch.push_back(std::move(item));
+            }
+            if (!batch.empty()) {
+                size_t size = batch.size();
+                handler_(batch);
+                published_.fetch_add(size, std::memory_order_relaxed);
+                batches_.fetch_add(1, std::memory_order_relaxed);
+                batch.clear();
+                continue;
+            }
+
+            if (stopping_.load(std::memory_order_acquire) && queue_.empty()) {
+                break;
+            }
+            if (spin_until_ready()) {
+                continue;
+            }
+
+            // Store y consultas seq_cst: la de stopping_ forma pareja con el
+            // exchange de stop() igual que la de la cola con el push
+            sleeping_.store(true, std::memory_order_seq_cst);
+            if (!queue_.empty() || stopping_.load(std::memory_order_seq_cst)) {
+                sleeping_.store(false, std::memory_order_relaxed);
+                continue;
+            }
+            sleeping_.wait(true);
+        }
+    }
+
+    // Espera activa corta: con tráfico continuo el siguiente evento llega
+    // antes de que merezca la pena dormir
+    bool spin_until_ready() {
+        if (spin_.count() == 0) {
+            return false;
+        }
+        auto deadline = std::chrono::steady_clock::now() + spin_;
+        do {
+            for (int i = 0; i < 64; ++i) {
+                if (!queue_.empty()) {
+                    return true;
+                }
+            }
+        } while (std::chrono::steady_clock::now() < deadline);
+        return false;
+    }
+
+    Handler handler_;
+    const size_t max_batch_;
+    const std::chrono::microseconds spin_;
+    MpscQueue<T> queue_;
+    std::atomic<bool> sleeping_{false};
+    std::atomic<bool> stopping_{false};
+    std::atomic<uint64_t> posted_{0};
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::thread thread_;
+};
+
+// Productor de eventos SSE: cada lote se publica con
+// SSEManager::publish_batch, así que una ráfaga cuesta un paso por los
+// mutex del manager y una escritura por conexión.
+class SseDispatcher : public BatchDispatcher<SseMessage> {
+public:
+    explicit SseDispatcher(SSEManager& manager, size_t max_batch = 256,
+                           std::chrono::microseconds spin = std::chrono::microseconds(50))
+        : BatchDispatcher([&manager](std::vector<SseMessage>& batch) {
+              manager.publish_batch(batch);
+          }, max_batch, spin) {}
+
+    using BatchDispatcher::post;
+
+    void post(std::string topic, std::string event, std::string data) {
+        post(SseMessage{std::move(topic), std::move(event), std::move(data)});
+    }
+
+    // Evento cuyo tema es su propio nombre (como SSEManager::broadcast_event)
+    void post(std::string event, std::string data) {
+        std::string topic = event;
+        post(std::move(topic), std::move(event), std::move(data));
+    }
+};
+
+#endif // SSE_DISPATCHER_HPP
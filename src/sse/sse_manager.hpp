@@ -0,0 +1,772 @@
+#ifndef SSE_MANAGER_HPP
+#define SSE_MANAGER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Evento SSE ya formateado para el cable. Se formatea una sola vez por
+// broadcast y todos los suscriptores comparten el mismo buffer.
+struct SseEvent {
+    uint64_t id = 0;     // Id monotónico (0 = evento de control sin id)
+    std::string topic;   // Tema al que se publicó (filtra el reenvío por Last-Event-ID)
+    std::string event;   // Nombre del evento (lo usa la política Coalesce)
+    std::string wire;    // "event: ...\ndata: ...\nid: ...\n\n"
+};
+
+using SsePayload = std::shared_ptr<const SseEvent>;
+
+// Evento pendiente de publicar, sin formatear (ver SseDispatcher)
+struct SseMessage {
+    std::string topic;
+    std::string event;
+    std::string data;
+    uint64_t id = 0;   // 0 = el siguiente; si no, un id propio (p. ej. una versión)
+};
+
+// Formatea un evento según el protocolo SSE. Cada línea de 'data' va en su
+// propia línea "data:" para que un salto de línea no corte el evento.
+inline SsePayload make_sse_event(std::string_view event, std::string_view data, uint64_t id,
+                                 std::string_view topic = {}) {
+    auto payload = std::make_shared<SseEvent>();
+    payload->id = id;
+    payload->topic.assign(topic);
+    payload->event.assign(event);
+
+    std::string& wire = payload->wire;
+    wire.reserve(event.size() + data.size() + 40);
+    wire.append("event: ").append(event).push_back('\n');
+    size_t start = 0;
+    while (true) {
+        size_t end = data.find('\n', start);
+        wire.append("data: ").append(data.substr(start, end - start)).push_back('\n');
+        if (end == std::string_view::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+    if (id != 0) {
+        wire.append("id: ").append(std::to_string(id));
+        wire.push_back('\n');
+    }
+    wire.push_back('\n');
+    return payload;
+}
+
+// Evento de control para un cliente que reconecta y cuyo Last-Event-ID ya
+// no está en el registro: debe recargar el estado completo. No lleva id,
+// así que el cliente conserva su último id. Lleva datos porque el
+// navegador no entrega los eventos con 'data' vacío.
+inline const SsePayload& sse_reset_event() {
+    static const SsePayload reset = make_sse_event("reset", "{}", 0);
+    return reset;
+}
+
+// Latido: una línea de comentario que el navegador ignora. Despierta a la
+// conexión sin eventos para que compruebe si su socket sigue abierto; no
+// termina la respuesta ni da de baja al suscriptor (ver sse_conexion.hpp).
+inline const SsePayload& sse_heartbeat_event() {
+    static const SsePayload heartbeat = [] {
+        auto payload = std::make_shared<SseEvent>();
+        payload->wire = ": ping\n\n";
+        return payload;
+    }();
+    return heartbeat;
+}
+
+// Registro circular de capacidad fija con los últimos eventos, en orden de
+// id. Permite reenviar a un cliente que reconecta exactamente lo que se
+// perdió, copiando los punteros sin volver a formatear. No es thread-safe:
+// lo protege quien lo usa.
+class SseEventLog {
+public:
+    explicit SseEventLog(size_t capacity) : ring_(capacity ? capacity : 1) {}
+
+    void append(SsePayload payload) {
+        last_id_ = payload->id;
+        if (size_ == ring_.size()) {
+            head_ = (head_ + 1) % ring_.size();
+            --size_;
+        }
+        ring_[(head_ + size_) % ring_.size()] = std::move(payload);
+        ++size_;
+    }
+
+    // Id del último evento registrado (0 si no hay ninguno)
+    uint64_t last_id() const {
+        return last_id_;
+    }
+
+    // Fija el último id ya emitido cuando los ids no empiezan en 1 (solo
+    // con el registro vacío)
+    void set_last_id(uint64_t id) {
+        if (size_ == 0) {
+            last_id_ = id;
+        }
+    }
+
+    // Añade a 'out' los eventos con id > last_id. Devuelve false si hay un
+    // hueco: eventos posteriores a last_id que ya salieron del registro, o
+    // un last_id que este servidor nunca emitió (p. ej. tras reiniciarse).
+    bool since(uint64_t last_id, std::vector<SsePayload>& out) const {
+        if (last_id > last_id_) {
+            return false;
+        }
+        if (last_id == last_id_) {
+            return true;
+        }
+        if (size_ == 0 || at(0)->id > last_id + 1) {
+            append_range(0, out);
+            return false;
+        }
+
+        // Los ids son crecientes: búsqueda binaria del primero > last_id
+        size_t lo = 0;
+        size_t hi = size_;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (at(mid)->id <= last_id) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        append_range(lo, out);
+        return true;
+    }
+
+private:
+    const SsePayload& at(size_t index) const {
+        return ring_[(head_ + index) % ring_.size()];
+    }
+
+    void append_range(size_t from, std::vector<SsePayload>& out) const {
+        out.reserve(out.size() + size_ - from);
+        for (size_t i = from; i < size_; ++i) {
+            out.push_back(at(i));
+        }
+    }
+
+    std::vector<SsePayload> ring_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+    uint64_t last_id_ = 0;
+};
+
+// Qué hacer cuando la cola de un suscriptor está llena
+enum class OverflowPolicy {
+    DropOldest,   // Descartar el evento más antiguo pendiente
+    DropClient,   // Cerrar el suscriptor (el cliente reconectará)
+    Coalesce      // Sustituir el último pendiente del mismo tipo; si no hay, DropOldest
+};
+
+struct SseOptions {
+    size_t queue_capacity = 256;
+    OverflowPolicy overflow = OverflowPolicy::DropOldest;
+    size_t log_capacity = 1024;   // Eventos recientes disponibles para Last-Event-ID
+
+    // Latido a los suscriptores sin eventos pendientes (0 = desactivado)
+    std::chrono::milliseconds heartbeat_interval{15000};
+    // Baja de los suscriptores que no entregan ningún evento en este tiempo
+    // (0 = desactivado). El latido no cuenta como actividad. Como Crow no
+    // avisa de que el cliente se fue mientras la respuesta sigue abierta,
+    // es el plazo en el que se recoge a un cliente caído: la baja termina
+    // la respuesta (una escritura real) y los vivos simplemente reconectan.
+    std::chrono::milliseconds idle_timeout{60000};
+    // Resolución de la rueda de temporización de inactividad
+    std::chrono::milliseconds wheel_tick{1000};
+    size_t wheel_slots = 64;
+};
+
+// Suscriptor SSE: una cola circular acotada de eventos compartidos. El
+// broadcast solo encola punteros; la escritura al socket la hace el bucle
+// de E/S de la propia conexión llamando a drain(). Cuando la cola pasa de
+// vacía a no vacía se llama a 'wake' para que ese bucle la drene.
+class SseSubscriber : public std::enable_shared_from_this<SseSubscriber> {
+    friend class SSEManager;
+
+public:
+    using WakeFunc = std::function<void(const std::shared_ptr<SseSubscriber>&)>;
+    using CloseFunc = std::function<void(const std::shared_ptr<SseSubscriber>&)>;
+    using clock = std::chrono::steady_clock;
+
+    SseSubscriber(size_t capacity, OverflowPolicy policy, WakeFunc wake, uint64_t start_after = 0,
+                  CloseFunc on_close = {})
+        : ring_(capacity ? capacity : 1), start_after_(start_after), cursor_(start_after), policy_(policy),
+          wake_(std::move(wake)), on_close_(std::move(on_close)),
+          last_active_(clock::now().time_since_epoch().count()) {}
+
+    // Los eventos con id <= start_after() ya se entregaron al suscribirse
+    // (o son anteriores a la suscripción) y el broadcast los omite
+    uint64_t start_after() const {
+        return start_after_;
+    }
+
+    // Id del último evento entregado por drain(), o start_after() si aún no
+    // ha entregado ninguno: el cliente ya tiene todo lo de sus temas hasta
+    // aquí y puede reanudar desde este id. Solo desde el bucle de E/S.
+    uint64_t cursor() const {
+        return cursor_;
+    }
+
+    // Encola un evento. Devuelve false si el suscriptor queda cerrado (o ya
+    // lo estaba) y hay que darlo de baja.
+    bool push(SsePayload payload) {
+        bool wake = false;
+        bool open = true;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (closed_) {
+                return false;
+            }
+
+            if (size_ == ring_.size() && !make_room(*payload)) {
+                // DropClient: se cierra y se avisa a la conexión para que termine
+                closed_ = true;
+                clear();
+                wake = true;
+                open = false;
+            } else {
+                ring_[(head_ + size_) % ring_.size()] = std::move(payload);
+                wake = size_++ == 0;
+            }
+        }
+
+        if (wake && wake_) {
+            wake_(shared_from_this());
+        }
+        return open;
+    }
+
+    // Encola 'payload' solo si la cola está vacía: con eventos pendientes la
+    // conexión ya tiene algo que escribir y el latido sobra (y con la cola
+    // llena haría descartar un evento). Devuelve false si está cerrado.
+    bool ping(const SsePayload& payload) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (closed_) {
+                return false;
+            }
+            if (size_ > 0) {
+                return true;
+            }
+            ring_[head_] = payload;
+            size_ = 1;
+        }
+
+        if (wake_) {
+            wake_(shared_from_this());
+        }
+        return true;
+    }
+
+    // Entrega en orden los eventos pendientes a 'sink(const std::string&)'.
+    // Solo debe llamarlo el bucle de E/S de la conexión; la escritura se
+    // hace sin mantener el mutex, así que un cliente lento no frena el
+    // broadcast. Una ráfaga de varios eventos se concatena y sale en una
+    // sola escritura. Devuelve el número de eventos entregados sin contar
+    // el latido, que se escribe pero no renueva last_active().
+    template<typename Sink>
+    size_t drain(Sink&& sink) {
+        size_t delivered = 0;
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                if (size_ == 0) {
+                    break;
+                }
+                for (; size_ > 0; --size_) {
+                    batch_.push_back(std::move(ring_[head_]));
+                    head_ = (head_ + 1) % ring_.size();
+                }
+            }
+
+            for (const auto& payload : batch_) {
+                cursor_ = std::max(cursor_, payload->id);
+                if (payload != sse_heartbeat_event()) {
+                    ++delivered;
+                }
+            }
+            if (batch_.size() == 1) {
+                sink(batch_.front()->wire);
+            } else {
+                write_buffer_.clear();
+                for (const auto& payload : batch_) {
+                    write_buffer_.append(payload->wire);
+                }
+                sink(write_buffer_);
+            }
+            batch_.clear();
+        }
+        if (delivered > 0) {
+            last_active_.store(clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        }
+        return delivered;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mtx_);
+        closed_ = true;
+        clear();
+    }
+
+    bool closed() const {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return closed_;
+    }
+
+    // Eventos descartados o sustituidos por desbordamiento
+    uint64_t dropped() const {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return dropped_;
+    }
+
+    // Última vez que la conexión entregó un evento (o el alta)
+    clock::time_point last_active() const {
+        return clock::time_point(clock::duration(last_active_.load(std::memory_order_relaxed)));
+    }
+
+private:
+    // Con la cola llena, hace sitio según la política. Devuelve false si la
+    // política es cerrar el suscriptor. Con Coalesce se elimina el pendiente
+    // más reciente del mismo tipo, ya que el nuevo lo sustituye.
+    bool make_room(const SseEvent& incoming) {
+        ++dropped_;
+        switch (policy_) {
+            case OverflowPolicy::DropClient:
+                return false;
+            case OverflowPolicy::Coalesce:
+                for (size_t i = size_; i-- > 0;) {
+                    SsePayload& pending = ring_[(head_ + i) % ring_.size()];
+                    if (pending->event == incoming.event) {
+                        // El resto mantiene su orden; el nuevo irá al final
+                        for (size_t j = i; j + 1 < size_; ++j) {
+                            ring_[(head_ + j) % ring_.size()] = std::move(ring_[(head_ + j + 1) % ring_.size()]);
+                        }
+                        --size_;
+                        return true;
+                    }
+                }
+                [[fallthrough]];
+            case OverflowPolicy::DropOldest:
+                ring_[head_].reset();
+                head_ = (head_ + 1) % ring_.size();
+                --size_;
+                return true;
+        }
+        return true;
+    }
+
+    void clear() {
+        for (; size_ > 0; --size_) {
+            ring_[head_].reset();
+            head_ = (head_ + 1) % ring_.size();
+        }
+    }
+
+    mutable std::mutex mtx_;
+    std::vector<SsePayload> ring_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+    bool closed_ = false;
+    uint64_t dropped_ = 0;
+    const uint64_t start_after_;
+    uint64_t cursor_;                 // Solo lo usa drain()
+    OverflowPolicy policy_;
+    WakeFunc wake_;
+    CloseFunc on_close_;              // Se llama una vez, al darlo de baja
+    std::vector<SsePayload> batch_;   // Solo lo usa drain()
+    std::string write_buffer_;        // Solo lo usa drain()
+    std::atomic<clock::rep> last_active_;
+
+    // Posición del suscriptor en el conjunto de cada uno de sus temas, para
+    // darlo de baja en O(1). La gestiona SSEManager con su mutex de temas
+    // en exclusiva.
+    struct Membership {
+        void* topic;
+        size_t index;
+    };
+    std::vector<Membership> memberships_;
+    size_t all_index_ = 0;            // Posición en la lista de todos los suscriptores
+    std::atomic<bool> subscribed_{false};
+};
+
+// Rueda de temporización (hashed timing wheel) para los plazos de
+// inactividad. Programar es O(1) y cada tick solo revisa su ranura. La
+// actividad de un suscriptor no mueve su entrada: cuando vence la ranura
+// se consulta el plazo real y, si aún no ha llegado, se reprograma, así que
+// un suscriptor activo cuesta una operación por plazo y no una por evento.
+// Guarda weak_ptr: las entradas de los que ya se dieron de baja se
+// descartan al vencer. No es thread-safe: la protege quien la usa.
+class SseTimerWheel {
+public:
+    using clock = std::chrono::steady_clock;
+
+    SseTimerWheel(clock::duration tick, size_t slots, clock::time_point start = clock::now())
+        : tick_(tick.count() > 0 ? tick : clock::duration(1)), slots_(slots ? slots : 1), start_(start) {}
+
+    void schedule(std::weak_ptr<SseSubscriber> subscriber, clock::time_point deadline) {
+        uint64_t tick = std::max(tick_of(deadline), current_ + 1);
+        slots_[tick % slots_.size()].push_back({std::move(subscriber), tick});
+    }
+
+    // Avanza hasta 'now'. 'deadline_of(const SseSubscriber&)' devuelve el
+    // plazo actual del suscriptor, o nullopt si ya no hay que vigilarlo; los
+    // que lo han superado se añaden a 'expired'.
+    template<typename DeadlineOf>
+    void advance(clock::time_point now, DeadlineOf&& deadline_of,
+                 std::vector<std::shared_ptr<SseSubscriber>>& expired) {
+        uint64_t target = tick_of(now);
+        if (target > current_ + slots_.size()) {
+            current_ = target - slots_.size();  // Una vuelta completa basta para verlo todo
+        }
+        while (current_ < target) {
+            ++current_;
+            std::vector<Entry>& slot = slots_[current_ % slots_.size()];
+            due_.swap(slot);
+            for (auto& entry : due_) {
+                if (entry.tick > current_) {
+                    slot.push_back(std::move(entry));  // Vence en una vuelta posterior
+                    continue;
+                }
+                std::shared_ptr<SseSubscriber> subscriber = entry.subscriber.lock();
+                if (!subscriber) {
+                    continue;
+                }
+                std::optional<clock::time_point> deadline = deadline_of(*subscriber);
+                if (!deadline) {
+                    continue;
+                }
+                if (*deadline <= now) {
+                    expired.push_back(std::move(subscriber));
+                } else {
+                    schedule(subscriber, *deadline);
+                }
+            }
+            due_.clear();
+        }
+    }
+
+private:
+    struct Entry {
+        std::weak_ptr<SseSubscriber> subscriber;
+        uint64_t tick;
+    };
+
+    uint64_t tick_of(clock::time_point time) const {
+        if (time <= start_) {
+            return 0;
+        }
+        return static_cast<uint64_t>((time - start_) / tick_);
+    }
+
+    clock::duration tick_;
+    std::vector<std::vector<Entry>> slots_;
+    std::vector<Entry> due_;   // Ranura en proceso (se reutiliza su capacidad)
+    clock::time_point start_;
+    uint64_t current_ = 0;     // Último tick procesado
+};
+
+// Manejador de conexiones SSE con suscripción por temas. Cada tema tiene su
+// propio conjunto de suscriptores (alta y baja en O(1) por intercambio con
+// el último) y publish() solo recorre los suscriptores del tema, más los
+// que no eligieron temas (tema comodín "*"). Cada evento se formatea una
+// sola vez, recibe un id monotónico de 64 bits y queda en un registro
+// circular para reenviarlo a los clientes que reconectan con Last-Event-ID.
+//
+// Ciclo de vida: la conexión llama a unsubscribe() tras entregar eventos o
+// si ve su socket cerrado. maintain() envía el latido (la conexión lo usa
+// para comprobar el socket, sin terminar la respuesta) y da de baja a los
+// suscriptores que llevan idle_timeout sin entregar ningún evento. Cada
+// baja avisa a la conexión con 'on_close'. Como Crow no informa de que el
+// cliente se fue mientras la respuesta sigue abierta, un suscriptor sin
+// eventos vive como mucho idle_timeout: los clientes vivos reconectan y
+// los caídos desaparecen.
+class SSEManager {
+public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr std::string_view all_topics = "*";
+
+    explicit SSEManager(SseOptions options = {})
+        : options_(options), log_(options.log_capacity), wheel_(options.wheel_tick, options.wheel_slots),
+          next_heartbeat_(clock::now() + options.heartbeat_interval) {}
+
+    // Alta de un suscriptor en 'topics' (vacío = todos los temas). Con
+    // 'last_event_id' se le encolan primero los eventos posteriores de sus
+    // temas que sigan en el registro; si falta alguno recibe antes un
+    // evento "reset". Reenvío y alta se hacen bajo el mutex del registro,
+    // así que no se pierde ni se duplica ningún evento entre el reenvío y
+    // los eventos en directo. 'wake' puede llamarse aquí mismo y debe
+    // limitarse a programar el drenado. 'on_close' se llama una sola vez,
+    // con el suscriptor, cuando se da de baja sea cual sea el motivo.
+    std::shared_ptr<SseSubscriber> subscribe(SseSubscriber::WakeFunc wake,
+                                             std::vector<std::string> topics = {},
+                                             std::optional<uint64_t> last_event_id = std::nullopt,
+                                             SseSubscriber::CloseFunc on_close = {}) {
+        if (topics.empty()) {
+            topics.emplace_back(all_topics);
+        }
+        std::sort(topics.begin(), topics.end());
+        topics.erase(std::unique(topics.begin(), topics.end()), topics.end());
+        bool all = std::binary_search(topics.begin(), topics.end(), all_topics);
+        if (all) {
+            // El comodín ya recibe todos los temas: con "*,x" cada evento de
+            // x llegaría dos veces
+            topics.assign(1, std::string(all_topics));
+        }
+
+        std::lock_guard<std::mutex> log_lock(log_mtx_);
+
+        std::vector<SsePayload> missed;
+        bool complete = !last_event_id || log_.since(*last_event_id, missed);
+        if (!all) {
+            missed.erase(std::remove_if(missed.begin(), missed.end(), [&topics](const SsePayload& payload) {
+                return !std::binary_search(topics.begin(), topics.end(), payload->topic);
+            }), missed.end());
+        }
+
+        auto subscriber = std::make_shared<SseSubscriber>(options_.queue_capacity + missed.size() + !complete,
+                                                          options_.overflow, std::move(wake), log_.last_id(),
+                                                          std::move(on_close));
+        if (!complete) {
+            subscriber->push(sse_reset_event());
+        }
+        for (auto& payload : missed) {
+            subscriber->push(std::move(payload));
+        }
+
+        std::unique_lock topics_lock(topics_mtx_);
+        subscriber->memberships_.reserve(topics.size());
+        for (const auto& name : topics) {
+            auto it = topics_.find(name);
+            if (it == topics_.end()) {
+                it = topics_.emplace(name, std::make_unique<Topic>(Topic{name, {}})).first;
+            }
+            Topic& topic = *it->second;
+            subscriber->memberships_.push_back({&topic, topic.members.size()});
+            topic.members.push_back(subscriber);
+        }
+        subscriber->all_index_ = all_.size();
+        all_.push_back(subscriber);
+        subscriber->subscribed_ = true;
+        ++subscriber_count_;
+        topics_lock.unlock();
+
+        if (options_.idle_timeout.count() > 0) {
+            std::lock_guard<std::mutex> wheel_lock(wheel_mtx_);
+            wheel_.schedule(subscriber, subscriber->last_active() + options_.idle_timeout);
+        }
+        return subscriber;
+    }
+
+    // Baja en O(1) por tema y aviso a la conexión. Se puede llamar más de
+    // una vez; solo la primera tiene efecto y devuelve true.
+    bool unsubscribe(const std::shared_ptr<SseSubscriber>& subscriber) {
+        subscriber->close();
+        if (!subscriber->subscribed_.exchange(false)) {
+            return false;
+        }
+
+        std::unique_lock topics_lock(topics_mtx_);
+        for (const auto& membership : subscriber->memberships_) {
+            Topic& topic = *static_cast<Topic*>(membership.topic);
+            std::shared_ptr<SseSubscriber> last = std::move(topic.members.back());
+            topic.members.pop_back();
+            if (last != subscriber) {
+                for (auto& moved : last->memberships_) {
+                    if (moved.topic == &topic) {
+                        moved.index = membership.index;
+                        break;
+                    }
+                }
+                topic.members[membership.index] = std::move(last);
+            }
+
+            // Los temas sin suscriptores se eliminan: los nombres los elige el cliente
+            if (topic.members.empty()) {
+                topics_.erase(topics_.find(topic.name));
+            }
+        }
+
+        std::shared_ptr<SseSubscriber> last = std::move(all_.back());
+        all_.pop_back();
+        if (last != subscriber) {
+            last->all_index_ = subscriber->all_index_;
+            all_[subscriber->all_index_] = std::move(last);
+        }
+        --subscriber_count_;
+        topics_lock.unlock();
+
+        if (subscriber->on_close_) {
+            subscriber->on_close_(subscriber);
+        }
+        return true;
+    }
+
+    // Un formato y un encolado de puntero por suscriptor del tema (y del
+    // comodín). Los suscriptores que se cierran por desbordamiento se dan
+    // de baja al terminar. Devuelve a cuántos se ha entregado. Se puede
+    // llamar desde cualquier hilo: las publicaciones se serializan para que
+    // cada suscriptor reciba los ids en orden creciente (ver delivery_mtx_).
+    size_t publish(std::string_view topic, std::string_view event, std::string_view data) {
+        std::lock_guard<std::mutex> delivery_lock(delivery_mtx_);
+        SsePayload payload;
+        {
+            std::lock_guard<std::mutex> log_lock(log_mtx_);
+            payload = make_sse_event(event, data, log_.last_id() + 1, topic);
+            log_.append(payload);
+        }
+        return deliver_all(std::span<const SsePayload>(&payload, 1));
+    }
+
+    // Publica varios eventos en orden con un solo paso por cada mutex: los
+    // ids se asignan juntos y cada suscriptor recibe la ráfaga entera antes
+    // de que su conexión la drene (una escritura en lugar de una por evento).
+    // Un id propio (SseMessage::id) se respeta si es mayor que el último;
+    // si no, se usa el siguiente para que los ids sigan siendo crecientes.
+    size_t publish_batch(std::span<const SseMessage> messages) {
+        std::lock_guard<std::mutex> delivery_lock(delivery_mtx_);
+        std::vector<SsePayload> payloads;
+        payloads.reserve(messages.size());
+        {
+            std::lock_guard<std::mutex> log_lock(log_mtx_);
+            for (const auto& message : messages) {
+                uint64_t id = std::max(message.id, log_.last_id() + 1);
+                payloads.push_back(make_sse_event(message.event, message.data, id, message.topic));
+                log_.append(payloads.back());
+            }
+        }
+        return deliver_all(payloads);
+    }
+
+    // Los ids continúan a partir de 'id' (p. ej. la versión actual de los
+    // datos que se publican). Solo tiene efecto antes del primer evento.
+    void start_ids_after(uint64_t id) {
+        std::lock_guard<std::mutex> log_lock(log_mtx_);
+        log_.set_last_id(id);
+    }
+
+    // Evento cuyo tema es su propio nombre
+    size_t broadcast_event(std::string_view event, std::string_view data) {
+        return publish(event, event, data);
+    }
+
+    size_t subscriber_count() const {
+        return subscriber_count_.load(std::memory_order_relaxed);
+    }
+
+    // Mantenimiento periódico: latido a los suscriptores sin eventos
+    // pendientes y baja de los inactivos. Debe llamarlo un único hilo, cada
+    // wheel_tick más o menos. Devuelve cuántos suscriptores se dieron de baja.
+    size_t maintain(clock::time_point now = clock::now()) {
+        std::vector<std::shared_ptr<SseSubscriber>> closed;
+
+        if (options_.heartbeat_interval.count() > 0 && now >= next_heartbeat_) {
+            next_heartbeat_ = now + options_.heartbeat_interval;
+            std::shared_lock topics_lock(topics_mtx_);
+            for (const auto& subscriber : all_) {
+                if (!subscriber->ping(sse_heartbeat_event())) {
+                    closed.push_back(subscriber);
+                }
+            }
+        }
+
+        if (options_.idle_timeout.count() > 0) {
+            std::lock_guard<std::mutex> wheel_lock(wheel_mtx_);
+            wheel_.advance(now, [this](const SseSubscriber& subscriber) -> std::optional<clock::time_point> {
+                if (!subscriber.subscribed_.load(std::memory_order_relaxed)) {
+                    return std::nullopt;
+                }
+                return subscriber.last_active() + options_.idle_timeout;
+            }, closed);
+        }
+
+        size_t removed = 0;
+        for (const auto& subscriber : closed) {
+            removed += unsubscribe(subscriber);
+        }
+        return removed;
+    }
+
+private:
+    struct Topic {
+        std::string name;
+        std::vector<std::shared_ptr<SseSubscriber>> members;
+    };
+
+    struct TopicHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    size_t deliver_all(std::span<const SsePayload> payloads) {
+        size_t delivered = 0;
+        std::vector<std::shared_ptr<SseSubscriber>> closed;
+        {
+            std::shared_lock topics_lock(topics_mtx_);
+            for (const auto& payload : payloads) {
+                deliver(payload->topic, payload, delivered, closed);
+                if (payload->topic != all_topics) {
+                    deliver(all_topics, payload, delivered, closed);
+                }
+            }
+        }
+
+        for (const auto& subscriber : closed) {
+            unsubscribe(subscriber);
+        }
+        return delivered;
+    }
+
+    void deliver(std::string_view name, const SsePayload& payload, size_t& delivered,
+                 std::vector<std::shared_ptr<SseSubscriber>>& closed) {
+        auto it = topics_.find(name);
+        if (it == topics_.end()) {
+            return;
+        }
+
+        for (const auto& subscriber : it->second->members) {
+            if (payload->id <= subscriber->start_after()) {
+                continue; // Ya lo recibió al suscribirse
+            }
+            if (subscriber->push(payload)) {
+                ++delivered;
+            } else {
+                closed.push_back(subscriber);
+            }
+        }
+    }
+
+    SseOptions options_;
+    // Se mantiene desde que se asigna el id hasta que se entrega: sin él, dos
+    // publicaciones concurrentes podrían encolar N+1 antes que N, la conexión
+    // terminaría su respuesta con id: N+1 y al reconectar N no se repetiría.
+    // Orden de adquisición: delivery_mtx_, log_mtx_, topics_mtx_.
+    std::mutex delivery_mtx_;
+    std::mutex log_mtx_;           // Protege log_ y el orden de los ids
+    SseEventLog log_;
+    std::shared_mutex topics_mtx_; // Compartido para publicar, exclusivo para altas y bajas (O(1) por tema)
+    std::unordered_map<std::string, std::unique_ptr<Topic>, TopicHash, std::equal_to<>> topics_;
+    std::vector<std::shared_ptr<SseSubscriber>> all_;  // Todos los suscriptores, para el latido
+    std::atomic<size_t> subscriber_count_{0};
+    std::mutex wheel_mtx_;
+    SseTimerWheel wheel_;
+    clock::time_point next_heartbeat_;  // Solo lo usa maintain()
+};
+
+#endif // SSE_MANAGER_HPP
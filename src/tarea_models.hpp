@@ -0,0 +1,28 @@
+#ifndef TAREA_MODELS_HPP
+#define TAREA_MODELS_HPP
+
+#include "base_model.hpp"
+#include <string>
+
+// Cuerpo de POST /api/tareas
+class NuevaTareaModel : public BaseModel<NuevaTareaModel>
+{
+public:
+    Field<std::string> titulo{"titulo", true};
+    Field<std::string> descripcion{"descripcion"};
+
+    REGISTER_FIELDS(titulo, descripcion)
+};
+
+// Cuerpo de PUT /api/tareas/:id
+class ActualizarTareaModel : public BaseModel<ActualizarTareaModel>
+{
+public:
+    Field<std::string> titulo{"titulo", true};
+    Field<std::string> descripcion{"descripcion", true};
+    Field<bool> completada{"completada", true};
+
+    REGISTER_FIELDS(titulo, descripcion, completada)
+};
+
+#endif // TAREA_MODELS_HPP
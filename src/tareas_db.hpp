@@ -0,0 +1,293 @@
+#ifndef TAREAS_DB_HPP
+#define TAREAS_DB_HPP
+
+#include "json_writer.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Estructura para representar una Tarea
+struct Tarea {
+    int id;
+    std::string titulo;
+    std::string descripcion;
+    bool completada;
+
+    // Serializador de Tarea compartido por todos los handlers. Las claves
+    // van ya escapadas como literales; solo se escapan los valores.
+    template<typename String>
+    void appendJson(String& out) const {
+        BasicJsonWriter<String> json(out);
+        json.raw("{\"id\":").number(id)
+            .raw(",\"titulo\":").string(titulo)
+            .raw(",\"descripcion\":").string(descripcion)
+            .raw(",\"completada\":").boolean(completada)
+            .raw('}');
+    }
+};
+
+// Las tareas almacenadas son inmutables: una actualización publica una
+// nueva versión y los lectores que aún usan la anterior no se ven afectados.
+using TareaPtr = std::shared_ptr<const Tarea>;
+
+// Vista inmutable de toda la colección, ordenada por id
+using TareasSnapshot = std::vector<TareaPtr>;
+
+// Parámetros de consulta del listado (paginación por clave + filtro)
+struct TareasConsulta {
+    int cursor = 0;                   // Devolver solo ids mayores que este
+    size_t limite = 0;                // 0 = sin límite
+    std::optional<bool> completada;   // Filtro opcional
+};
+
+// Operación de una escritura, para el feed de cambios
+enum class OperacionTarea : uint8_t {
+    Crear,
+    Actualizar,
+    Eliminar
+};
+
+inline const char* nombreOperacion(OperacionTarea op) {
+    switch (op) {
+        case OperacionTarea::Crear:      return "crear";
+        case OperacionTarea::Actualizar: return "actualizar";
+        case OperacionTarea::Eliminar:   return "eliminar";
+    }
+    return "";
+}
+
+// Registro compacto de un cambio: qué operación, sobre qué id y la versión
+// de la colección que deja (cada escritura la incrementa en uno)
+struct CambioTarea {
+    OperacionTarea op;
+    int id;
+    uint64_t version;
+
+    // {"op":"crear","id":3,"version":7}
+    template<typename String>
+    void appendJson(String& out) const {
+        BasicJsonWriter<String> json(out);
+        json.raw("{\"op\":").string(nombreOperacion(op))
+            .raw(",\"id\":").number(id)
+            .raw(",\"version\":").number(version)
+            .raw('}');
+    }
+};
+
+// Base de datos en memoria particionada por id.
+// Cada shard tiene su propio shared_mutex: las lecturas de un mismo shard
+// corren en paralelo y las escrituras solo bloquean su shard.
+class TareasDB {
+public:
+    static constexpr size_t num_shards = 16;
+
+private:
+    struct Shard {
+        mutable std::shared_mutex mtx;
+        std::vector<TareaPtr> tareas;            // Almacenamiento contiguo
+        std::unordered_map<int, size_t> indice;  // id -> posición en 'tareas'
+    };
+
+    struct SnapshotCache {
+        uint64_t version;
+        std::shared_ptr<const TareasSnapshot> tareas;
+    };
+
+    std::array<Shard, num_shards> shards;
+    std::atomic<int> siguiente_id;
+
+    // Se incrementa en cada escritura; invalida el snapshot publicado
+    std::atomic<uint64_t> version{0};
+    mutable std::atomic<std::shared_ptr<const SnapshotCache>> snapshot_cache;
+    mutable std::mutex reconstruccion_mtx;   // Solo un lector reconstruye a la vez
+
+    // Recibe cada cambio ya aplicado (ver observarCambios)
+    std::function<void(const CambioTarea&)> observador;
+
+    Shard& shard_de(int id) {
+        return shards[static_cast<size_t>(id) % num_shards];
+    }
+
+    const Shard& shard_de(int id) const {
+        return shards[static_cast<size_t>(id) % num_shards];
+    }
+
+    void insertar(TareaPtr tarea) {
+        Shard& shard = shard_de(tarea->id);
+        std::unique_lock lock(shard.mtx);
+        shard.indice.emplace(tarea->id, shard.tareas.size());
+        int id = tarea->id;
+        shard.tareas.push_back(std::move(tarea));
+        CambioTarea cambio = registrarCambio(OperacionTarea::Crear, id);
+        lock.unlock();
+        notificar(cambio);
+    }
+
+    // Llamado con el mutex del shard tomado: así dos cambios del mismo id
+    // reciben versiones en el orden en que se aplicaron. Entre shards las
+    // versiones no se serializan con ningún mutex global, así que pueden
+    // notificarse desordenadas (ver observarCambios).
+    CambioTarea registrarCambio(OperacionTarea op, int id) {
+        return CambioTarea{op, id, version.fetch_add(1, std::memory_order_release) + 1};
+    }
+
+    // Llamado ya sin el mutex del shard
+    void notificar(const CambioTarea& cambio) const {
+        if (observador) {
+            observador(cambio);
+        }
+    }
+
+    // Solo copia punteros: los strings de cada tarea se comparten
+    std::shared_ptr<const SnapshotCache> reconstruir_snapshot(uint64_t v) const {
+        auto tareas = std::make_shared<TareasSnapshot>();
+        for (const auto& shard : shards) {
+            std::shared_lock lock(shard.mtx);
+            tareas->insert(tareas->end(), shard.tareas.begin(), shard.tareas.end());
+        }
+        std::sort(tareas->begin(), tareas->end(),
+                  [](const TareaPtr& a, const TareaPtr& b) { return a->id < b->id; });
+
+        return std::make_shared<const SnapshotCache>(SnapshotCache{v, std::move(tareas)});
+    }
+
+public:
+    TareasDB() : siguiente_id(1) {
+        // Datos de ejemplo
+        insertar(std::make_shared<const Tarea>(Tarea{siguiente_id++, "Aprender Crow", "Crear una API REST con C++", false}));
+        insertar(std::make_shared<const Tarea>(Tarea{siguiente_id++, "Hacer ejercicio", "Correr 5km", true}));
+    }
+
+    TareaPtr crear(std::string titulo, std::string descripcion) {
+        auto nueva = std::make_shared<const Tarea>(
+            Tarea{siguiente_id.fetch_add(1, std::memory_order_relaxed), std::move(titulo), std::move(descripcion), false});
+        insertar(nueva);
+        return nueva;
+    }
+
+    // Snapshot inmutable y compartido de todas las tareas, ordenadas por id.
+    // Se reconstruye de forma perezosa solo si hubo escrituras desde el
+    // último, y nunca se devuelve uno anterior a la versión vista al entrar:
+    // quien acaba de escribir siempre lee su escritura. Solo reconstruye un
+    // lector; los que llegan mientras tanto esperan y reutilizan su snapshot
+    // si ya incluye lo que necesitan, en lugar de ordenar en paralelo. En
+    // 'version_snapshot' se deja una versión que el snapshot ya incluye (si
+    // coincide con una escritura concurrente, puede incluir alguna más):
+    // reanudar el feed de cambios desde ella no pierde ninguno.
+    std::shared_ptr<const TareasSnapshot> snapshot(uint64_t* version_snapshot = nullptr) const {
+        auto cache = snapshot_cache.load(std::memory_order_acquire);
+        uint64_t necesaria = version.load(std::memory_order_acquire);
+        if (!cache || cache->version < necesaria) {
+            std::lock_guard lock(reconstruccion_mtx);
+            // Otro lector puede haberlo reconstruido mientras esperábamos
+            cache = snapshot_cache.load(std::memory_order_acquire);
+            if (!cache || cache->version < necesaria) {
+                cache = reconstruir_snapshot(version.load(std::memory_order_acquire));
+                snapshot_cache.store(cache, std::memory_order_release);
+            }
+        }
+
+        if (version_snapshot) {
+            *version_snapshot = cache->version;
+        }
+        return cache->tareas;
+    }
+
+    uint64_t versionActual() const {
+        return version.load(std::memory_order_acquire);
+    }
+
+    // Recibe cada cambio justo después de aplicarlo, desde el hilo que
+    // escribe y ya sin mutex. Las versiones son consecutivas y no se repiten,
+    // pero escrituras concurrentes en shards distintos pueden llegar en
+    // cualquier orden: quien necesite el orden de versión debe reordenar
+    // (ver FeedCambios). Se configura antes de atender peticiones.
+    void observarCambios(std::function<void(const CambioTarea&)> funcion) {
+        observador = std::move(funcion);
+    }
+
+    // Recorre el snapshot aplicando la consulta y llama a 'visitar' por cada
+    // tarea seleccionada. Devuelve el cursor de la página siguiente (el id
+    // de la última tarea devuelta) solo si queda alguna tarea que cumpla el
+    // filtro. El inicio se localiza por búsqueda binaria sobre el id.
+    template<typename Visitor>
+    static std::optional<int> recorrer(const TareasSnapshot& tareas, const TareasConsulta& consulta,
+                                       Visitor&& visitar) {
+        auto it = std::upper_bound(tareas.begin(), tareas.end(), consulta.cursor,
+                                   [](int cursor, const TareaPtr& t) { return cursor < t->id; });
+
+        size_t emitidas = 0;
+        int ultima = consulta.cursor;
+        for (; it != tareas.end(); ++it) {
+            const Tarea& tarea = **it;
+            if (consulta.completada && tarea.completada != *consulta.completada) {
+                continue;
+            }
+            if (consulta.limite && emitidas == consulta.limite) {
+                return ultima;
+            }
+            visitar(tarea);
+            ultima = tarea.id;
+            ++emitidas;
+        }
+        return std::nullopt;
+    }
+
+    TareaPtr obtenerPorId(int id) const {
+        const Shard& shard = shard_de(id);
+        std::shared_lock lock(shard.mtx);
+        auto it = shard.indice.find(id);
+        return it != shard.indice.end() ? shard.tareas[it->second] : nullptr;
+    }
+
+    // Copy-on-write: se sustituye la tarea por una nueva versión
+    bool actualizar(int id, std::string titulo, std::string descripcion, bool completada) {
+        auto nueva = std::make_shared<const Tarea>(Tarea{id, std::move(titulo), std::move(descripcion), completada});
+
+        Shard& shard = shard_de(id);
+        std::unique_lock lock(shard.mtx);
+        auto it = shard.indice.find(id);
+        if (it == shard.indice.end()) {
+            return false;
+        }
+        shard.tareas[it->second] = std::move(nueva);
+        CambioTarea cambio = registrarCambio(OperacionTarea::Actualizar, id);
+        lock.unlock();
+        notificar(cambio);
+        return true;
+    }
+
+    // O(1): se mueve la última tarea del shard al hueco (swap-and-pop)
+    bool eliminar(int id) {
+        Shard& shard = shard_de(id);
+        std::unique_lock lock(shard.mtx);
+        auto it = shard.indice.find(id);
+        if (it == shard.indice.end()) {
+            return false;
+        }
+
+        size_t pos = it->second;
+        shard.indice.erase(it);
+        if (pos != shard.tareas.size() - 1) {
+            shard.tareas[pos] = std::move(shard.tareas.back());
+            shard.indice[shard.tareas[pos]->id] = pos;
+        }
+        shard.tareas.pop_back();
+        CambioTarea cambio = registrarCambio(OperacionTarea::Eliminar, id);
+        lock.unlock();
+        notificar(cambio);
+        return true;
+    }
+};
+
+#endif // TAREAS_DB_HPP
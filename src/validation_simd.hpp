@@ -0,0 +1,226 @@
+#ifndef VALIDATION_SIMD_HPP
+#define VALIDATION_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define VALIDATION_SIMD_X86 1
+#define VALIDATION_SIMD_AVX2 __attribute__((target("avx2")))
+#endif
+
+// Kernels de validación por lotes sobre bloques contiguos de hasta 64
+// valores: cada uno devuelve una máscara con un bit por valor que incumple
+// la regla. Para int32, int64 y double hay versión AVX2; se elige en tiempo
+// de ejecución (o directamente en compilación con -march=native / -mavx2)
+// y, si la CPU o el compilador no la admiten, se usa la versión escalar.
+namespace validation_simd
+{
+
+// Tamaño máximo del bloque que reciben los kernels
+constexpr size_t block_size = 64;
+
+// Tipos con kernel vectorial
+template <typename T>
+constexpr bool vectorized = std::is_same_v<T, double> ||
+                            (std::is_integral_v<T> && std::is_signed_v<T> && !std::is_same_v<T, bool> &&
+                             (sizeof(T) == 4 || sizeof(T) == 8));
+
+inline bool has_avx2()
+{
+#if defined(__AVX2__)
+    return true;
+#elif defined(VALIDATION_SIMD_X86)
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// --- Versión escalar (cualquier tipo comparable) ---
+
+template <typename T>
+uint64_t out_of_range_scalar(const T *values, size_t count, bool has_min, T min, bool has_max, T max)
+{
+    uint64_t mask = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        bool out = (has_min & (values[i] < min)) | (has_max & (values[i] > max));
+        mask |= uint64_t{out} << i;
+    }
+    return mask;
+}
+
+template <typename T>
+uint64_t not_in_scalar(const T *values, size_t count, const T *allowed, size_t allowed_count)
+{
+    uint64_t mask = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        bool found = false;
+        for (size_t j = 0; j < allowed_count; ++j)
+        {
+            found |= values[i] == allowed[j];
+        }
+        mask |= uint64_t{!found} << i;
+    }
+    return mask;
+}
+
+#if defined(VALIDATION_SIMD_X86)
+
+// --- AVX2: un juego de primitivas por tipo de carril ---
+
+struct Avx2Int32
+{
+    using value_type = int32_t;
+    using vector = __m256i;
+    static constexpr size_t lanes = 8;
+
+    VALIDATION_SIMD_AVX2 static vector load(const void *p) { return _mm256_loadu_si256(static_cast<const __m256i *>(p)); }
+    VALIDATION_SIMD_AVX2 static vector broadcast(int32_t v) { return _mm256_set1_epi32(v); }
+    VALIDATION_SIMD_AVX2 static vector none() { return _mm256_setzero_si256(); }
+    VALIDATION_SIMD_AVX2 static vector less(vector a, vector b) { return _mm256_cmpgt_epi32(b, a); }
+    VALIDATION_SIMD_AVX2 static vector equal(vector a, vector b) { return _mm256_cmpeq_epi32(a, b); }
+    VALIDATION_SIMD_AVX2 static vector either(vector a, vector b) { return _mm256_or_si256(a, b); }
+    VALIDATION_SIMD_AVX2 static uint32_t bits(vector m) { return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(m))); }
+};
+
+struct Avx2Int64
+{
+    using value_type = int64_t;
+    using vector = __m256i;
+    static constexpr size_t lanes = 4;
+
+    VALIDATION_SIMD_AVX2 static vector load(const void *p) { return _mm256_loadu_si256(static_cast<const __m256i *>(p)); }
+    VALIDATION_SIMD_AVX2 static vector broadcast(int64_t v) { return _mm256_set1_epi64x(v); }
+    VALIDATION_SIMD_AVX2 static vector none() { return _mm256_setzero_si256(); }
+    VALIDATION_SIMD_AVX2 static vector less(vector a, vector b) { return _mm256_cmpgt_epi64(b, a); }
+    VALIDATION_SIMD_AVX2 static vector equal(vector a, vector b) { return _mm256_cmpeq_epi64(a, b); }
+    VALIDATION_SIMD_AVX2 static vector either(vector a, vector b) { return _mm256_or_si256(a, b); }
+    VALIDATION_SIMD_AVX2 static uint32_t bits(vector m) { return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(m))); }
+};
+
+struct Avx2Double
+{
+    using value_type = double;
+    using vector = __m256d;
+    static constexpr size_t lanes = 4;
+
+    VALIDATION_SIMD_AVX2 static vector load(const void *p) { return _mm256_loadu_pd(static_cast<const double *>(p)); }
+    VALIDATION_SIMD_AVX2 static vector broadcast(double v) { return _mm256_set1_pd(v); }
+    VALIDATION_SIMD_AVX2 static vector none() { return _mm256_setzero_pd(); }
+    // Comparaciones ordenadas: NaN no es menor, mayor ni igual a nada (igual que en escalar)
+    VALIDATION_SIMD_AVX2 static vector less(vector a, vector b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    VALIDATION_SIMD_AVX2 static vector equal(vector a, vector b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    VALIDATION_SIMD_AVX2 static vector either(vector a, vector b) { return _mm256_or_pd(a, b); }
+    VALIDATION_SIMD_AVX2 static uint32_t bits(vector m) { return static_cast<uint32_t>(_mm256_movemask_pd(m)); }
+};
+
+// Los kernels AVX2 solo recorren vectores completos ('count' múltiplo de
+// Ops::lanes); el resto del bloque lo completa la versión escalar.
+template <typename Ops, typename T>
+VALIDATION_SIMD_AVX2 uint64_t out_of_range_avx2(const T *values, size_t count, bool has_min, T min,
+                                                 bool has_max, T max)
+{
+    using vector = typename Ops::vector;
+    using Lane = typename Ops::value_type;
+    const vector lo = Ops::broadcast(static_cast<Lane>(min));
+    const vector hi = Ops::broadcast(static_cast<Lane>(max));
+
+    uint64_t mask = 0;
+    for (size_t i = 0; i < count; i += Ops::lanes)
+    {
+        vector value = Ops::load(values + i);
+        vector out = Ops::either(has_min ? Ops::less(value, lo) : Ops::none(),
+                                 has_max ? Ops::less(hi, value) : Ops::none());
+        mask |= uint64_t{Ops::bits(out)} << i;
+    }
+    return mask;
+}
+
+// Compare-any: cada vector de valores contra toda la whitelist (pensado
+// para whitelists pequeñas)
+template <typename Ops, typename T>
+VALIDATION_SIMD_AVX2 uint64_t not_in_avx2(const T *values, size_t count, const T *allowed, size_t allowed_count)
+{
+    using vector = typename Ops::vector;
+    using Lane = typename Ops::value_type;
+    constexpr uint32_t lane_bits = (1u << Ops::lanes) - 1;
+
+    uint64_t mask = 0;
+    for (size_t i = 0; i < count; i += Ops::lanes)
+    {
+        vector value = Ops::load(values + i);
+        vector found = Ops::none();
+        for (size_t j = 0; j < allowed_count; ++j)
+        {
+            found = Ops::either(found, Ops::equal(value, Ops::broadcast(static_cast<Lane>(allowed[j]))));
+        }
+        mask |= uint64_t{~Ops::bits(found) & lane_bits} << i;
+    }
+    return mask;
+}
+
+template <typename T>
+using Avx2Ops = std::conditional_t<std::is_same_v<T, double>, Avx2Double,
+                                   std::conditional_t<sizeof(T) == 4, Avx2Int32, Avx2Int64>>;
+
+#endif // VALIDATION_SIMD_X86
+
+// --- Puntos de entrada con despacho ---
+
+// Bits de los valores fuera de [min, max]; un límite ausente no se comprueba
+template <typename T>
+uint64_t out_of_range(const T *values, size_t count, bool has_min, T min, bool has_max, T max)
+{
+#if defined(VALIDATION_SIMD_X86)
+    if constexpr (vectorized<T>)
+    {
+        if (has_avx2())
+        {
+            using Ops = Avx2Ops<T>;
+            size_t vector_count = count - count % Ops::lanes;
+            uint64_t mask = out_of_range_avx2<Ops>(values, vector_count, has_min, min, has_max, max);
+            if (vector_count < count)
+            {
+                mask |= out_of_range_scalar(values + vector_count, count - vector_count, has_min, min,
+                                            has_max, max) << vector_count;
+            }
+            return mask;
+        }
+    }
+#endif
+    return out_of_range_scalar(values, count, has_min, min, has_max, max);
+}
+
+// Bits de los valores que no están en 'allowed'
+template <typename T>
+uint64_t not_in(const T *values, size_t count, const T *allowed, size_t allowed_count)
+{
+#if defined(VALIDATION_SIMD_X86)
+    if constexpr (vectorized<T>)
+    {
+        if (has_avx2())
+        {
+            using Ops = Avx2Ops<T>;
+            size_t vector_count = count - count % Ops::lanes;
+            uint64_t mask = not_in_avx2<Ops>(values, vector_count, allowed, allowed_count);
+            if (vector_count < count)
+            {
+                mask |= not_in_scalar(values + vector_count, count - vector_count, allowed, allowed_count)
+                        << vector_count;
+            }
+            return mask;
+        }
+    }
+#endif
+    return not_in_scalar(values, count, allowed, allowed_count);
+}
+
+} // namespace validation_simd
+
+#endif // VALIDATION_SIMD_HPP
@@ -1,12 +1,65 @@
 #include "crow.h"
-#include <unordered_set>
-#include <mutex>
+#include "salas.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Salas de una conexión. Solo las tocan los handlers de su conexión, que
+// Crow no ejecuta en paralelo. Las salas guardan la conexión en sí: Crow la
+// destruye al volver de onclose, y antes onclose la saca de todas sus
+// salas (salir() espera a que termine cualquier envío en curso a la sala).
+class ClienteWs {
+public:
+    const std::vector<std::string>& salas() const {
+        return salas_;
+    }
+
+    void anotarSala(std::string_view sala) {
+        salas_.emplace_back(sala);
+    }
+
+    void olvidarSala(std::string_view sala) {
+        auto it = std::find(salas_.begin(), salas_.end(), sala);
+        if (it != salas_.end()) {
+            salas_.erase(it);
+        }
+    }
+
+private:
+    std::vector<std::string> salas_;
+};
+
+// Cliente de la conexión, creado en onopen y liberado en onclose
+static ClienteWs& clienteDe(crow::websocket::connection& conn) {
+    return *static_cast<ClienteWs*>(conn.userdata());
+}
+
+// Mensajes de control: "/join sala" y "/leave sala". Todo lo demás se
+// publica en las salas del cliente.
+static bool esControl(std::string_view data, std::string_view comando, std::string_view& sala) {
+    constexpr size_t max_nombre = 64;
+    if (data.size() <= comando.size() || data.substr(0, comando.size()) != comando ||
+        data[comando.size()] != ' ') {
+        return false;
+    }
+    sala = data.substr(comando.size() + 1);
+    return !sala.empty() && sala.size() <= max_nombre;
+}
 
 int main() {
     crow::SimpleApp app;
     
-    std::unordered_set<crow::websocket::connection*> users;
-    std::mutex mtx;
+    // Salas: un mensaje solo llega a los miembros de las salas del emisor.
+    // Varios shards por hilo de Crow, para que las altas y bajas en salas
+    // distintas casi nunca compartan mutex.
+    constexpr size_t max_salas_cliente = 16;
+    const std::string sala_inicial = "general";
+    Salas<crow::websocket::connection> salas(4 * std::max(1u, std::thread::hardware_concurrency()));
+    std::atomic<size_t> conectados{0};
 
     // Configurar directorio de templates
     crow::mustache::set_base("templates");
@@ -22,23 +75,65 @@ int main() {
     CROW_ROUTE(app, "/ws")       
       .websocket(&app)      
       .onopen([&](crow::websocket::connection& conn){
-          std::lock_guard<std::mutex> lock(mtx);
-          users.insert(&conn);
-          CROW_LOG_INFO << "Cliente conectado. Total: " << users.size();
+          auto* cliente = new ClienteWs;
+          conn.userdata(cliente);
+          cliente->anotarSala(sala_inicial);
+          salas.unir(sala_inicial, &conn);
+          CROW_LOG_INFO << "Cliente conectado. Total: " << ++conectados;
       })
       .onclose([&](crow::websocket::connection& conn, const std::string& reason){
-          std::lock_guard<std::mutex> lock(mtx);
-          users.erase(&conn);
-          CROW_LOG_INFO << "Cliente desconectado. Total: " << users.size();
+          std::unique_ptr<ClienteWs> cliente(&clienteDe(conn));
+          conn.userdata(nullptr);
+
+          for(const auto& sala : cliente->salas()) {
+              salas.salir(sala, &conn);
+          }
+          CROW_LOG_INFO << "Cliente desconectado. Total: " << --conectados;
       })
       .onmessage([&](crow::websocket::connection& conn, const std::string& data, bool is_binary){
-          std::lock_guard<std::mutex> lock(mtx);
-          // Broadcast: enviar mensaje a todos los clientes conectados
-          for(auto u : users) {
-              if(is_binary)
-                  u->send_binary(data);
-              else
-                  u->send_text(data);
+          ClienteWs& cliente = clienteDe(conn);
+
+          std::string_view sala;
+          if(!is_binary && esControl(data, "/join", sala)) {
+              const auto& suyas = cliente.salas();
+              if(std::find(suyas.begin(), suyas.end(), sala) != suyas.end()) {
+                  return;
+              }
+              if(suyas.size() == max_salas_cliente) {
+                  conn.send_text("Demasiadas salas");
+                  return;
+              }
+              salas.unir(std::string(sala), &conn);
+              cliente.anotarSala(sala);
+              conn.send_text("Unido a " + std::string(sala));
+              return;
+          }
+          if(!is_binary && esControl(data, "/leave", sala)) {
+              if(salas.salir(sala, &conn)) {
+                  cliente.olvidarSala(sala);
+                  conn.send_text("Has salido de " + std::string(sala));
+              }
+              return;
+          }
+
+          // Publicar solo en las salas del cliente. El texto se enmarca una
+          // vez por sala ("[sala] mensaje") y todos sus miembros reciben ese
+          // mismo buffer (send_text lo copia en la cola de cada conexión).
+          // send_text solo encola en el hilo de la conexión, así que se puede
+          // llamar desde cualquier hilo sin más bloqueo que el de la sala.
+          std::string mensaje;
+          for(const auto& nombre : cliente.salas()) {
+              if(!is_binary) {
+                  mensaje.assign("[").append(nombre).append("] ").append(data);
+              }
+              const std::string& enviado = is_binary ? data : mensaje;
+              salas.publicar(nombre, [&](crow::websocket::connection& miembro) {
+                  if(is_binary) {
+                      miembro.send_binary(enviado);
+                  } else {
+                      miembro.send_text(enviado);
+                  }
+              });
           }
       });
 
@@ -0,0 +1,151 @@
+#ifndef SALAS_HPP
+#define SALAS_HPP
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Salas (canales) con la pertenencia particionada por nombre de sala. Cada
+// shard tiene su propio shared_mutex y su tabla de salas: unirse o salir de
+// salas de shards distintos no compite, y publicar solo toma el shard en
+// modo compartido el tiempo de buscar la sala. Cada sala guarda sus
+// miembros en un conjunto con su propio mutex (no shared_mutex: con envíos
+// continuos, el de glibc dejaría sin turno a las altas y bajas). Enviar a
+// una sala solo bloquea las altas, bajas y envíos de esa sala; altas y
+// bajas son O(1).
+//
+// Las salas no son dueñas de los clientes: cada cliente debe salir de
+// todas sus salas antes de destruirse. Como el envío se hace con la sala
+// bloqueada, después de salir ningún envío puede seguir usándolo.
+template<typename Cliente>
+class Salas {
+public:
+    explicit Salas(size_t num_shards = 16) : shards_(num_shards ? num_shards : 1) {}
+
+    Salas(const Salas&) = delete;
+    Salas& operator=(const Salas&) = delete;
+
+    // Devuelve false si el cliente ya estaba en la sala
+    bool unir(const std::string& nombre, Cliente* cliente) {
+        Shard& shard = shard_de(nombre);
+        while (true) {
+            std::shared_ptr<Sala> sala;
+            {
+                std::unique_lock lock(shard.mtx);
+                auto it = shard.salas.find(nombre);
+                if (it == shard.salas.end()) {
+                    it = shard.salas.emplace(nombre, std::make_shared<Sala>()).first;
+                } else if (it->second->borrada.load(std::memory_order_acquire)) {
+                    it->second = std::make_shared<Sala>();  // Su baja aún no la ha quitado
+                }
+                sala = it->second;
+            }
+
+            // Sin el mutex del shard: un envío largo a esta sala no frena
+            // a las demás salas del shard
+            std::lock_guard<std::mutex> sala_lock(sala->mtx);
+            if (sala->borrada.load(std::memory_order_relaxed)) {
+                continue;  // Se vació mientras tanto: buscarla de nuevo
+            }
+            return sala->miembros.insert(cliente).second;
+        }
+    }
+
+    // Devuelve false si el cliente no estaba en la sala. Las salas vacías
+    // se eliminan: los nombres los eligen los clientes.
+    bool salir(std::string_view nombre, Cliente* cliente) {
+        std::shared_ptr<Sala> sala = buscar(nombre);
+        if (!sala) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> sala_lock(sala->mtx);
+            if (sala->miembros.erase(cliente) == 0) {
+                return false;
+            }
+            if (!sala->miembros.empty()) {
+                return true;
+            }
+            sala->borrada.store(true, std::memory_order_release);
+        }
+
+        Shard& shard = shard_de(nombre);
+        std::unique_lock lock(shard.mtx);
+        auto it = shard.salas.find(nombre);
+        if (it != shard.salas.end() && it->second == sala) {
+            shard.salas.erase(it);
+        }
+        return true;
+    }
+
+    // Llama a 'enviar(Cliente&)' por cada miembro de la sala, con la sala
+    // bloqueada: nadie sale de ella a mitad del envío.
+    // 'enviar' no debe unirse ni salir de salas. Devuelve a cuántos envió.
+    template<typename Enviar>
+    size_t publicar(std::string_view nombre, Enviar&& enviar) const {
+        std::shared_ptr<Sala> sala = buscar(nombre);
+        if (!sala) {
+            return 0;
+        }
+
+        std::lock_guard<std::mutex> sala_lock(sala->mtx);
+        for (Cliente* miembro : sala->miembros) {
+            enviar(*miembro);
+        }
+        return sala->miembros.size();
+    }
+
+    size_t num_salas() const {
+        size_t total = 0;
+        for (const auto& shard : shards_) {
+            std::shared_lock lock(shard.mtx);
+            total += shard.salas.size();
+        }
+        return total;
+    }
+
+private:
+    struct Sala {
+        std::mutex mtx;
+        std::unordered_set<Cliente*> miembros;
+        std::atomic<bool> borrada{false};   // Vacía: se quita (o sustituye) en su shard
+    };
+
+    struct NombreHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view nombre) const {
+            return std::hash<std::string_view>{}(nombre);
+        }
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mtx;
+        std::unordered_map<std::string, std::shared_ptr<Sala>, NombreHash, std::equal_to<>> salas;
+    };
+
+    Shard& shard_de(std::string_view nombre) {
+        return shards_[NombreHash{}(nombre) % shards_.size()];
+    }
+
+    const Shard& shard_de(std::string_view nombre) const {
+        return shards_[NombreHash{}(nombre) % shards_.size()];
+    }
+
+    std::shared_ptr<Sala> buscar(std::string_view nombre) const {
+        const Shard& shard = shard_de(nombre);
+        std::shared_lock lock(shard.mtx);
+        auto it = shard.salas.find(nombre);
+        return it != shard.salas.end() ? it->second : nullptr;
+    }
+
+    std::vector<Shard> shards_;
+};
+
+#endif // SALAS_HPP
@@ -0,0 +1,95 @@
+// La validación que tiene éxito no reserva memoria: se cuentan las llamadas
+// a operator new alrededor de validate() y de FieldValidator::check(). Los
+// errores se devuelven como códigos y el mensaje solo se formatea al pedirlo.
+//
+//   make tests
+
+#include "base_model.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// GCC avisa de free() sobre memoria de operator new aunque aquí ambos
+// están reemplazados y son malloc/free
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+static size_t reservas = 0;
+
+void* operator new(size_t bytes) {
+    ++reservas;
+    if (void* p = std::malloc(bytes ? bytes : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+class UsuarioModel : public BaseModel<UsuarioModel> {
+public:
+    Field<std::string> username = CreateField<std::string>("username", true, 3, 20);
+    Field<std::string> email = [] {
+        FieldOptions<std::string> opciones;
+        opciones.required = true;
+        opciones.pattern = "^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\\.[a-zA-Z]{2,}$";
+        return Field<std::string>("email", opciones);
+    }();
+    Field<int> edad = CreateField<int>("edad", true, 18, 120);
+    Field<std::string> rol = CreateField<std::string>("rol", false, std::vector<std::string>{"admin", "user"});
+
+    REGISTER_FIELDS(username, email, edad, rol)
+};
+
+// Reservas que hace 'f'
+template<typename F>
+size_t contarReservas(F&& f) {
+    size_t antes = reservas;
+    f();
+    return reservas - antes;
+}
+
+int main() {
+    UsuarioModel usuario;
+    usuario.username = "john_doe";
+    usuario.email = "john@example.com";
+    usuario.edad = 30;
+    usuario.rol = "user";
+
+    bool valido = false;
+    assert(contarReservas([&] { valido = usuario.validate().valid(); }) == 0);
+    assert(valido);
+
+    FieldOptions<int> rango;
+    rango.min_value = 0;
+    rango.max_value = 10;
+    FieldValidator<int> validador("n", rango);
+    bool sin_error = false;
+    assert(contarReservas([&] { sin_error = !validador.check(5); }) == 0);
+    assert(sin_error);
+
+    // Fallos: códigos compactos, sin mensaje hasta que se pide
+    usuario.email = "john";
+    usuario.edad = 10;
+    auto resultado = usuario.validate();
+    assert(!resultado);
+    assert(resultado.errors().size() == 2);
+    assert(resultado.errors()[0].field_index == 1);
+    assert(resultado.errors()[0].rule == ValidationRule::Pattern);
+    assert(resultado.errors()[1].field_index == 2);
+    assert(resultado.errors()[1].rule == ValidationRule::MinValue);
+    assert(resultado.errors()[1].bound == 18);
+
+    auto mensajes = resultado.messages();
+    assert(mensajes.size() == 2);
+    assert(mensajes[1].find("edad") != std::string::npos);
+
+    std::puts("validacion_sin_reservas: ok");
+    return 0;
+}